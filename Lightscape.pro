@@ -78,6 +78,9 @@ DEFINES +=
     GIT_COMMIT_DATE=\\"\"\"$$GIT_COMMIT_DATE\\"\"\"                                             \
     GIT_BRANCH=\\"\"\"$$GIT_BRANCH\\"\"\"                                                       \
 
+# Frame loop tracing (LOG_TRACE) is only compiled into debug builds
+CONFIG(debug, debug|release):DEFINES += LIGHTSCAPE_TRACE
+
 #-----------------------------------------------------------------------------------------------#
 # Resources                                                                                     #
 #-----------------------------------------------------------------------------------------------#
@@ -108,11 +111,21 @@ INCLUDEPATH +=
 #-----------------------------------------------------------------------------------------------#
 HEADERS +=                                                                                      \
     include/core/Types.h                                                                        \
+    include/core/Span.h                                                                         \
+    include/core/SeqLock.h                                                                      \
+    include/core/FrameArena.h                                                                   \
     include/core/LightscapePlugin.h                                                             \
+    include/devices/ControllerSource.h                                                          \
+    include/devices/DeviceHandle.h                                                              \
     include/devices/DeviceManager.h                                                             \
+    include/devices/DeviceNameIndex.h                                                           \
+    include/devices/DeviceNotifier.h                                                            \
+    include/devices/DeviceOutputPool.h                                                          \
+    include/devices/MockControllerBackend.h                                                     \
     include/core/LightscapeWidget.h                                                             \
     include/core/EnhancedLightscapeWidget.h                                                     \
     include/core/SettingsManager.h                                                              \
+    include/core/SettingsWriter.h                                                               \
     include/core/ThemeManager.h                                                                 \
     include/core/ResourceHandler.h                                                              \
     include/core/TrayMenuManager.h                                                              \
@@ -122,6 +135,7 @@ HEADERS +=
     include/core/SetupTestDialog.h                                                              \
     include/core/SetupTestUtility.h                                                             \
     include/core/GridValidator.h                                                                \
+    include/core/LayoutFile.h                                                                   \
     include/core/TestGridVisualizer.h                                                           \
     include/core/PositionTestTab.h                                                              \
     include/core/LayerTestTab.h                                                                 \
@@ -130,6 +144,7 @@ HEADERS +=
     include/grid/ReferencePointSelector.h                                                       \
     include/grid/GridTypes.h                                                                    \
     include/grid/SpatialGrid.h                                                                  \
+    include/grid/SpatialField.h                                                                 \
     include/grid/GridPanel.h                                                                    \
     include/grid/GridSettingsDialog.h                                                           \
     include/grid/NonRGBGridManager.h                                                            \
@@ -145,8 +160,16 @@ HEADERS +=
     include/effects/EffectRegistry.h                                                            \
     include/effects/EffectManager.h                                                             \
     include/effects/BaseEffect.h                                                                \
+    include/effects/ColorScale.h                                                                \
     include/effects/TestEffect/TestEffect.h                                                     \
     include/effects/SpatialControllerZone.h                                                     \
+    include/effects/FrameCompositor.h                                                           \
+    include/effects/FrameScheduler.h                                                            \
+    include/effects/RenderSnapshot.h                                                            \
+    include/effects/PositionBatch.h                                                             \
+    include/effects/EffectParameters.h                                                          \
+    include/effects/LayerBlend.h                                                                \
+    include/effects/FrameStatistics.h                                                           \
     include/effects/EffectTabHeader.h                                                           \
     include/effects/EffectTabWidget.h                                                           \
     include/effects/PreviewRenderer.h                                                           \
@@ -160,6 +183,7 @@ HEADERS +=
     include/effects/EffectStateManager.h                                                        \
     include/effects/panels/EffectsListPanel.h                                                   \
     include/effects/panels/EffectsControlPanel.h                                                \
+    include/effects/panels/FrameStatsView.h                                                     \
     include/effects/panels/EffectsPreviewPanel.h                                                \
     include/effects/panels/DeviceListPanel.h                                                    \
 
@@ -169,18 +193,25 @@ HEADERS +=
 SOURCES +=                                                                                      \
     src/core/LightscapePlugin.cpp                                                               \
     src/devices/DeviceManager.cpp                                                               \
+    src/devices/DeviceNameIndex.cpp                                                             \
+    src/devices/DeviceNotifier.cpp                                                              \
+    src/devices/DeviceOutputPool.cpp                                                            \
+    src/devices/MockControllerBackend.cpp                                                       \
     src/core/LightscapeWidget.cpp                                                               \
     src/core/EnhancedLightscapeWidget.cpp                                                       \
     src/core/SettingsManager.cpp                                                                \
+    src/core/SettingsWriter.cpp                                                                 \
     src/core/ThemeManager.cpp                                                                   \
     src/core/ResourceHandler.cpp                                                                \
     src/core/TrayMenuManager.cpp                                                                \
     src/core/StateManager.cpp                                                                   \
     src/core/VersionManager.cpp                                                                 \
     src/core/LoggingManager.cpp                                                                 \
+    src/core/FrameArena.cpp                                                                     \
     src/core/SetupTestDialog.cpp                                                                \
     src/core/SetupTestUtility.cpp                                                               \
     src/core/GridValidator.cpp                                                                  \
+    src/core/LayoutFile.cpp                                                                     \
     src/core/TestGridVisualizer.cpp                                                             \
     src/core/PositionTestTab.cpp                                                                \
     src/core/LayerTestTab.cpp                                                                   \
@@ -188,6 +219,7 @@ SOURCES +=
     src/core/ValidationTab.cpp                                                                  \
     src/grid/ReferencePointSelector.cpp                                                         \
     src/grid/SpatialGrid.cpp                                                                    \
+    src/grid/SpatialField.cpp                                                                   \
     src/grid/GridPanel.cpp                                                                      \
     src/grid/GridSettingsDialog.cpp                                                             \
     src/grid/NonRGBGridManager.cpp                                                              \
@@ -201,8 +233,13 @@ SOURCES +=
     src/effects/EffectRegistry.cpp                                                              \
     src/effects/EffectManager.cpp                                                               \
     src/effects/BaseEffect.cpp                                                                  \
+    src/effects/ColorScale.cpp                                                                  \
     src/effects/TestEffect/TestEffect.cpp                                                       \
     src/effects/SpatialControllerZone.cpp                                                       \
+    src/effects/FrameCompositor.cpp                                                             \
+    src/effects/LayerBlend.cpp                                                                  \
+    src/effects/FrameStatistics.cpp                                                             \
+    src/effects/FrameScheduler.cpp                                                              \
     src/effects/EffectTabHeader.cpp                                                             \
     src/effects/EffectTabWidget.cpp                                                             \
     src/effects/PreviewRenderer.cpp                                                             \
@@ -216,6 +253,7 @@ SOURCES +=
     src/effects/EffectStateManager.cpp                                                          \
     src/effects/panels/EffectsListPanel.cpp                                                     \
     src/effects/panels/EffectsControlPanel.cpp                                                  \
+    src/effects/panels/FrameStatsView.cpp                                                       \
     src/effects/panels/EffectsPreviewPanel.cpp                                                  \
     src/effects/panels/DeviceListPanel.cpp                                                      \
 
@@ -24,6 +24,8 @@ class EnhancedLightscapeWidget : public QWidget
 
 public:
     explicit EnhancedLightscapeWidget(ResourceManager* resourceManager = nullptr, QWidget* parent = nullptr);
+    // Drives the given controllers instead of OpenRGB's (mock backend)
+    explicit EnhancedLightscapeWidget(ControllerSource* controllerSource, QWidget* parent = nullptr);
     ~EnhancedLightscapeWidget();
 
     // Core functionality
@@ -40,6 +42,8 @@ private slots:
     void onSetupTestClicked();
 
 private:
+    EnhancedLightscapeWidget(ResourceManager* resourceManager, DeviceManager* deviceManager, QWidget* parent);
+
     void setupWidgets();
     void setupConnections();
 
@@ -0,0 +1,73 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameArena.h                                              |
+|                                                           |
+| Bump allocator for per-frame temporaries                  |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "core/Span.h"
+
+namespace Lightscape {
+
+/**
+ * Scratch memory for one frame. allocate() bumps a pointer through a single
+ * block and reset() hands all of it back at once, so a frame's temporaries
+ * cost no heap traffic. A frame that needs more than the block holds gets
+ * overflow blocks; the next reset() replaces them with one block as large as
+ * the busiest frame so far, after which frames of that size never allocate.
+ *
+ * Nothing is destroyed on reset(), so only trivially destructible types can
+ * be allocated. Spans are valid until the next reset(). Not thread-safe: one
+ * arena per thread that renders.
+ */
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t capacity = 4096);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // 'count' value-initialized elements
+    template<typename T>
+    Span<T> allocate(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "FrameArena only aligns to fundamental alignment");
+        if (count == 0) return Span<T>();
+
+        T* data = static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+        for (size_t i = 0; i < count; i++) {
+            new (data + i) T();
+        }
+        return Span<T>(data, count);
+    }
+
+    // Start the next frame; invalidates every span handed out so far
+    void reset();
+
+    size_t getCapacity() const { return _capacity; }
+    size_t getUsed() const { return _offset + _overflowBytes; }
+    size_t getHighWater() const { return _highWater; }
+
+private:
+    void* allocateBytes(size_t size, size_t alignment);
+
+    std::unique_ptr<unsigned char[]> _block;
+    size_t _capacity = 0;
+    size_t _offset = 0;
+
+    std::vector<std::unique_ptr<unsigned char[]>> _overflow;
+    size_t _overflowBytes = 0;
+    size_t _highWater = 0;
+};
+
+} // namespace Lightscape
@@ -0,0 +1,78 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| LayoutFile.h                                              |
+|                                                           |
+| Versioned binary container for layouts and profiles      |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QCborArray>
+#include <QCborValue>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <optional>
+
+/**
+ * CBOR file made of named sections (grid, assignments, non-RGB devices,
+ * effects, names). Each section is stored as its own encoded byte string,
+ * so reading a file only splits it into sections; a section is decoded
+ * when someone asks for it.
+ *
+ * Layout on disk: self-describe tag 55799 around the map
+ *   { "format": "lightscape", "version": N, "sections": { name: bytes } }
+ */
+class LayoutFile
+{
+public:
+    static constexpr int FormatVersion = 1;
+
+    static const QString GridSection;
+    static const QString AssignmentsSection;
+    static const QString NonRGBDevicesSection;
+    static const QString EffectsSection;
+    static const QString NamesSection;
+
+    void setSection(const QString& name, const QCborValue& value);
+    bool hasSection(const QString& name) const;
+    QStringList sectionNames() const;
+
+    // Decodes the section on every call; an absent section is undefined
+    QCborValue section(const QString& name) const;
+
+    int version() const { return fileVersion; }
+
+    QByteArray toCbor() const;
+    static std::optional<LayoutFile> fromCbor(const QByteArray& data, QString* error = nullptr);
+
+    // Cheap check on the leading bytes, used to tell binary files from JSON ones
+    static bool isLayoutData(const QByteArray& data);
+
+private:
+    int fileVersion = FormatVersion;
+    QMap<QString, QCborValue> values;    // set by the writer
+    QMap<QString, QByteArray> encoded;   // read from a file, not decoded yet
+};
+
+/**
+ * Interned string table. Repeated device, zone and LED names are stored
+ * once and referenced by index; -1 means "no name".
+ */
+class LayoutNameTable
+{
+public:
+    int intern(const QString& name);
+    QString name(int ref) const;
+    int size() const { return names.size(); }
+
+    QCborArray toCbor() const;
+    static LayoutNameTable fromCbor(const QCborArray& array);
+
+private:
+    QStringList names;
+    QHash<QString, int> refs;
+};
@@ -21,6 +21,7 @@
 
 class EnhancedLightscapeWidget;
 class DeviceManager;
+class MockControllerBackend;
 
 class LightscapePlugin : public QObject, public OpenRGBPluginInterface
 {
@@ -52,6 +53,7 @@ private slots:
 
 private:
     bool initializePlugin(bool dark_theme, ResourceManager* resource_manager);
+    bool initializeResources(ResourceManager* resource_manager);
     void handlePluginError(const QString& error);
 
     ResourceHandler* resource_handler;
@@ -59,4 +61,5 @@ private:
     StateManager* state_manager;
     EnhancedLightscapeWidget* widget;
     DeviceManager* device_manager;
+    MockControllerBackend* mock_backend;
 };
@@ -15,6 +15,8 @@
 #include <QVector>
 #include <QStandardPaths>
 #include <QDir>
+#include <atomic>
+#include <chrono>
 
 namespace Lightscape {
 
@@ -61,6 +63,44 @@ struct LogMessage {
  * ```
  */
 
+/**
+ * @brief Per-call-site limiter for messages that could fire every frame.
+ *
+ * Lets MaxPerSecond messages through per one-second window and counts the
+ * rest, so the next message that gets through can say how many were dropped.
+ */
+class LogRateLimiter {
+public:
+    static constexpr int MaxPerSecond = 5;
+    
+    bool allow(int& suppressed) {
+        int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        
+        int64_t windowStart = _windowStart.load(std::memory_order_relaxed);
+        if (now - windowStart >= 1000 &&
+            _windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+            _count.store(0, std::memory_order_relaxed);
+        }
+        
+        if (_count.fetch_add(1, std::memory_order_relaxed) < MaxPerSecond) {
+            suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+        
+        _suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    // printf-style formatting, only called once a message is allowed through
+    static QString format(int suppressed, const char* fmt, ...) Q_ATTRIBUTE_FORMAT_PRINTF(2, 3);
+    
+private:
+    std::atomic<int64_t> _windowStart{0};
+    std::atomic<int> _count{0};
+    std::atomic<int> _suppressed{0};
+};
+
 // Forward declaration for QMessageHandler
 class LoggingManager;
 void logRedirectHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
@@ -80,6 +120,7 @@ public:
     void info(const QString& message);
     void debug(const QString& message);
     void verbose(const QString& message);
+    void log(LogLevel level, const QString& message);
     
     // Check if a given log level is enabled
     bool isEnabled(LogLevel level) const;
@@ -151,4 +192,31 @@ private:
 // Macros for conditional logging checks
 #define IS_LOG_ENABLED(level) Lightscape::LoggingManager::getInstance().isEnabled(level)
 
+// Rate-limited, lazily formatted logging for code that runs every frame.
+// The level is checked first, so a disabled level never touches the limiter's
+// shared counters; the message is only formatted when both let it through.
+#define LOG_THROTTLED(level, ...)                                                               \
+    do {                                                                                        \
+        static Lightscape::LogRateLimiter lightscapeLimiter;                                    \
+        int lightscapeSuppressed = 0;                                                           \
+        if (IS_LOG_ENABLED(level) && lightscapeLimiter.allow(lightscapeSuppressed)) {           \
+            Lightscape::LoggingManager::getInstance().log(level,                                \
+                Lightscape::LogRateLimiter::format(lightscapeSuppressed, __VA_ARGS__));         \
+        }                                                                                       \
+    } while (0)
+
+// Frame loop tracing. Compiled out unless LIGHTSCAPE_TRACE is defined (debug builds).
+// In release builds the arguments still type-check but sit in dead code, so
+// nothing is evaluated or formatted.
+#ifdef LIGHTSCAPE_TRACE
+#define LOG_TRACE(...) LOG_THROTTLED(Lightscape::LogLevel::Verbose, __VA_ARGS__)
+#else
+#define LOG_TRACE(...)                                                                          \
+    do {                                                                                        \
+        if (false) {                                                                            \
+            (void)Lightscape::LogRateLimiter::format(0, __VA_ARGS__);                           \
+        }                                                                                       \
+    } while (0)
+#endif
+
 } // namespace Lightscape
\ No newline at end of file
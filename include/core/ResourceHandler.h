@@ -10,6 +10,7 @@
 
 #include <QObject>
 #include "ResourceManager.h"
+#include "devices/ControllerSource.h"
 
 class ResourceHandler : public QObject
 {
@@ -20,9 +21,13 @@ public:
     ~ResourceHandler();
 
     bool initialize(ResourceManager* manager);
+    // Runs on stand-in controllers instead of OpenRGB's (MockControllerBackend)
+    bool initialize(ControllerSource* source);
     void cleanup();
     bool isInitialized() const;
     ResourceManager* getResourceManager() const;
+    // Null unless initialized with a controller source
+    ControllerSource* getControllerSource() const;
 
     // Error handling
     bool hasError() const;
@@ -38,6 +43,7 @@ private:
     void setError(const QString& error);
 
     ResourceManager* _resource_manager;
+    ControllerSource* _controller_source;
     bool _initialized;
     QString _last_error;
 };
\ No newline at end of file
@@ -0,0 +1,92 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| SeqLock.h                                                 |
+|                                                           |
+| Lock-free single-writer value publication                 |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace Lightscape {
+
+/**
+ * Sequence lock around a trivially copyable value. One thread stores, any
+ * number of threads load; neither side ever blocks on a mutex. A load that
+ * overlaps a store simply retries, so readers never see a torn value.
+ *
+ * The payload lives in relaxed atomic words, which keeps the concurrent
+ * copy well-defined without requiring T itself to be atomic.
+ */
+template<typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock needs a trivially copyable type");
+
+public:
+    SeqLock() { store(T()); }
+    explicit SeqLock(const T& value) { store(value); }
+
+    // Writer side - only one thread may call this
+    void store(const T& value)
+    {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);   // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WordCount; i++) {
+            _words[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        _sequence.store(sequence + 2, std::memory_order_release);   // even: stable
+    }
+
+    // Reader side - any thread
+    T load() const
+    {
+        Words words;
+        uint32_t before;
+        uint32_t after;
+
+        do {
+            before = _sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t i = 0; i < WordCount; i++) {
+                words[i] = _words[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = _sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    // Changes every time a new value is stored
+    uint32_t version() const { return _sequence.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    using Words = std::array<uint64_t, WordCount>;
+
+    std::atomic<uint32_t> _sequence{0};
+    std::array<std::atomic<uint64_t>, WordCount> _words{};
+};
+
+} // namespace Lightscape
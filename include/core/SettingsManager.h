@@ -3,9 +3,13 @@
 #include <QObject>
 #include <QJsonObject>
 #include <QString>
+#include <optional>
 #include "grid/SpatialGrid.h"
 #include "devices/NonRGBDeviceManager.h"
 #include "devices/DeviceManager.h"
+#include "core/SettingsWriter.h"
+
+class QTimer;
 
 class SettingsManager : public QObject
 {
@@ -20,19 +24,76 @@ public:
 
     void initialize(SpatialGrid* grid, NonRGBDeviceManager* nonRGBManager, DeviceManager* deviceManager);
 
+    struct PersistenceStats
+    {
+        quint64 saveRequests = 0;   // change notifications received
+        quint64 snapshots = 0;      // states handed to the writer
+        quint64 filesWritten = 0;
+        quint64 writeFailures = 0;
+        quint64 writesAvoided = 0;  // coalesced or superseded before reaching disk
+    };
+
+    // Changes are written at most once per delay window
+    void setSaveDelay(int milliseconds);
+
+    // Writes any pending change and waits until it is on disk
+    void flush();
+
+    PersistenceStats getPersistenceStats() const;
+
+    // The settings file is binary (CBOR); JSON stays available for exchange
+    bool exportJson(const QString& path);
+    bool importJson(const QString& path);
+    static LayoutFile layoutFromJson(const QJsonObject& state);
+    static QJsonObject layoutToJson(const LayoutFile& layout);
+
 private slots:
     void saveState();
+    void writeState();
+    void remapAssignments();
 
 private:
+    // An assignment whose device, zone or LED is gone, off the grid and kept by
+    // name until they come back; saved with the rest so it survives a restart
+    struct ParkedAssignment
+    {
+        GridPosition pos;
+        DeviceAssignment assignment;
+        QString deviceName;
+        QString zoneName;
+        QString ledName;
+    };
+
     SettingsManager(QObject* parent = nullptr);
     ~SettingsManager() = default;
     
     void loadState();
+    LayoutFile captureLayout();
+    QCborArray encodeAssignment(const DeviceAssignment& assignment, LayoutNameTable& names) const;
+    std::optional<DeviceAssignment> resolveParkedAssignment(const ParkedAssignment& parked) const;
+    bool restoreParkedAssignment(const ParkedAssignment& parked);
+    std::optional<LayoutFile> readLayout() const;
+    std::optional<LayoutFile> readJsonLayout(const QString& path) const;
+    void applyLayout(const LayoutFile& layout);
     QString getSettingsPath() const;
+    QString getLegacySettingsPath() const;
 
     SpatialGrid* spatialGrid;
     NonRGBDeviceManager* nonRGBDeviceManager;
     DeviceManager* deviceManager;
+    bool restoringState = false;
+
+    // Device names as of the last time grid indices were known to be right
+    DeviceNameIndex assignmentNames;
+
+    QList<ParkedAssignment> parkedAssignments;
+
+    static constexpr int DefaultSaveDelayMs = 500;
+    QTimer* saveTimer;
+    SettingsWriter writer;
+    quint64 saveRequests = 0;
+    quint64 coalescedRequests = 0;
 
-    QString settingsFileName = "lightscape_state.json";
+    QString settingsFileName = "lightscape_state.cbor";
+    QString legacySettingsFileName = "lightscape_state.json";
 };
\ No newline at end of file
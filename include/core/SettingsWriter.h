@@ -0,0 +1,63 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| SettingsWriter.h                                          |
+|                                                           |
+| Background writer for the settings file                  |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include "core/LayoutFile.h"
+#include <QString>
+#include <QtGlobal>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * Encodes settings snapshots and writes them on its own thread. Only the
+ * newest snapshot matters, so a submit replaces one that is still waiting.
+ * Files are written through QSaveFile (temp file + rename), so a crash
+ * mid-write leaves the previous file intact.
+ */
+class SettingsWriter
+{
+public:
+    struct Stats
+    {
+        quint64 queued = 0;      // snapshots submitted
+        quint64 superseded = 0;  // replaced before they were written
+        quint64 written = 0;
+        quint64 failed = 0;
+    };
+
+    SettingsWriter() = default;
+    ~SettingsWriter();
+
+    SettingsWriter(const SettingsWriter&) = delete;
+    SettingsWriter& operator=(const SettingsWriter&) = delete;
+
+    void submit(const QString& path, const LayoutFile& layout);
+
+    // Blocks until every submitted snapshot is on disk
+    void flush();
+
+    Stats stats() const;
+
+private:
+    void run();
+    bool writeFile(const QString& path, const LayoutFile& layout);
+
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+
+    bool stopping = false;
+    bool hasPending = false;
+    bool writing = false;
+    QString pendingPath;
+    LayoutFile pendingLayout;
+    Stats counters;
+};
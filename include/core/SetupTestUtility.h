@@ -166,13 +166,24 @@ private:
     void applyColorToPosition(const GridPosition& pos, const RGBColor& color);
     
     /**
-     * @brief Calculate distance between two positions
+     * @brief Write a color to every assignment at a position into a write batch
      * 
-     * @param pos1 First position
-     * @param pos2 Second position
-     * @return float Distance
+     * The devices are updated when the batch commits, once each.
+     * 
+     * @param pos Grid position
+     * @param color Color to apply
+     * @param batch Batch collecting the writes
+     */
+    void applyColorToAssignments(const GridPosition& pos, const RGBColor& color,
+                                 DeviceManager::ColorWriteBatch& batch);
+    
+    /**
+     * @brief Evaluate a pattern for all assigned positions and apply it
+     * 
+     * @param pattern Pattern type (1 = distance, 2 = wave)
+     * @return bool False if there is nothing to apply
      */
-    float calculateDistance(const GridPosition& pos1, const GridPosition& pos2) const;
+    bool applyPattern(int pattern);
     
     /**
      * @brief Create a color based on distance
@@ -0,0 +1,74 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| Span.h                                                    |
+|                                                           |
+| Non-owning views over contiguous data                     |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Lightscape {
+
+/**
+ * Non-owning, read-only view over a contiguous array (a minimal stand-in
+ * for C++20 std::span<const T>). The view is only valid while the owner
+ * of the data keeps it alive and unmodified.
+ */
+template<typename T>
+class ConstSpan
+{
+public:
+    ConstSpan() = default;
+    ConstSpan(const T* data, size_t size) : _data(data), _size(size) {}
+    ConstSpan(const std::vector<T>& vector) : _data(vector.data()), _size(vector.size()) {}
+
+    const T* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+
+    const T& operator[](size_t index) const { return _data[index]; }
+
+    const T* begin() const { return _data; }
+    const T* end() const { return _data + _size; }
+
+private:
+    const T* _data = nullptr;
+    size_t _size = 0;
+};
+
+/**
+ * Writable counterpart of ConstSpan (std::span<T>), e.g. for memory handed
+ * out by a FrameArena. Converts to a ConstSpan wherever one is expected.
+ */
+template<typename T>
+class Span
+{
+public:
+    Span() = default;
+    Span(T* data, size_t size) : _data(data), _size(size) {}
+    Span(std::vector<T>& vector) : _data(vector.data()), _size(vector.size()) {}
+
+    T* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+
+    T& operator[](size_t index) const { return _data[index]; }
+
+    T* begin() const { return _data; }
+    T* end() const { return _data + _size; }
+
+    // The first 'count' elements
+    Span first(size_t count) const { return Span(_data, count < _size ? count : _size); }
+
+    operator ConstSpan<T>() const { return ConstSpan<T>(_data, _size); }
+
+private:
+    T* _data = nullptr;
+    size_t _size = 0;
+};
+
+} // namespace Lightscape
@@ -0,0 +1,29 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| ControllerSource.h                                        |
+|                                                           |
+| Supplies the RGB controllers DeviceManager drives         |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include "RGBController.h"
+
+/**
+ * Where DeviceManager gets its controller list from. Inside OpenRGB this wraps
+ * the ResourceManager; headless tools supply stand-in controllers instead, so
+ * the output path can run without the OpenRGB runtime.
+ */
+class ControllerSource
+{
+public:
+    virtual ~ControllerSource() = default;
+    virtual std::vector<RGBController*>& GetRGBControllers() = 0;
+
+    // Held by DeviceManager while it reads the list. A source that can change
+    // the list while frames render returns a lock on it; the default is empty.
+    virtual std::unique_lock<std::mutex> LockControllers() { return std::unique_lock<std::mutex>(); }
+};
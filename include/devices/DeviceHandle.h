@@ -0,0 +1,31 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| DeviceHandle.h                                            |
+|                                                           |
+| Resolved reference to one RGB controller                  |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QtGlobal>
+#include "RGBController.h"
+
+/**
+ * An RGB controller resolved by DeviceManager::ResolveDevice(). The index was
+ * bounds-checked and the counts were read when the handle was made, so writes
+ * through a handle only compare against them. A handle belongs to one
+ * generation of the controller list; after a rescan it must be rebound
+ * (DeviceManager::RebindDevice), which follows the controller to its new
+ * index or invalidates the handle when the controller is gone.
+ */
+struct DeviceHandle
+{
+    RGBController* controller = nullptr;
+    quint64 generation = 0;
+    int index = -1;
+    unsigned int zoneCount = 0;
+    unsigned int ledCount = 0;
+
+    bool IsValid() const { return controller != nullptr; }
+};
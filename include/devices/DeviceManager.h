@@ -5,19 +5,33 @@
 #include <QList>
 #include <QMap>
 #include <QPair>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include "ResourceManager.h"
 #include "RGBController.h"
+#include "devices/ControllerSource.h"
+#include "devices/DeviceHandle.h"
+#include "devices/DeviceNameIndex.h"
+#include "devices/DeviceNotifier.h"
+#include "devices/DeviceOutputPool.h"
+#include "core/Span.h"
 #include "core/Types.h"
 #include "devices/NonRGBDevice.h"
 #include "grid/GridTypes.h"
 
+class QTimer;
+
 class DeviceManager : public QObject
 {
     Q_OBJECT
 
 public:
     explicit DeviceManager(ResourceManager* resourceManager = nullptr, QObject* parent = nullptr);
-    virtual ~DeviceManager() {}
+    // Drive controllers from another source (headless tools); resourceManager stays null
+    explicit DeviceManager(ControllerSource* source, QObject* parent);
+    virtual ~DeviceManager();
 
     // Resource Manager Access (needed by DeviceEffectManager)
     ResourceManager* resourceManager;
@@ -38,6 +52,92 @@ public:
     bool SetDeviceColor(int deviceIndex, RGBColor color);
     bool UpdateDevice(int deviceIndex);
 
+    // Controller handles (any thread). RefreshControllers() compares the
+    // controller list with the cached table and starts a new generation when
+    // it changed, queueing deviceListChanged; the other calls refresh first.
+    // OpenRGB rescans and hotplug trigger a refresh on their own.
+    quint64 RefreshControllers() const;
+    DeviceHandle ResolveDevice(int deviceIndex) const;
+    std::vector<DeviceHandle> GetDeviceHandles() const;
+    bool RebindDevice(DeviceHandle& handle) const;
+    bool SetLEDColor(const DeviceHandle& device, int ledIndex, RGBColor color);
+    bool SetZoneColor(const DeviceHandle& device, int zoneIndex, RGBColor color);
+
+    // Bulk color writes: one pass into controller->colors and no hardware
+    // update; push the result with UpdateDevice() or use a ColorWriteBatch.
+    // A single color is repeated over the whole range, otherwise 'colors'
+    // holds one color per LED (device and zone writes start at the first LED).
+    bool WriteDeviceColors(const DeviceHandle& device, Lightscape::ConstSpan<RGBColor> colors);
+    bool WriteZoneColors(const DeviceHandle& device, int zoneIndex, Lightscape::ConstSpan<RGBColor> colors);
+    bool WriteLEDColors(const DeviceHandle& device, Lightscape::ConstSpan<int> ledIndices, Lightscape::ConstSpan<RGBColor> colors);
+    bool UpdateDevice(const DeviceHandle& device);
+
+    // Collects color writes to any number of devices and updates each touched
+    // device once, on Commit() or when the batch goes out of scope
+    class ColorWriteBatch {
+    public:
+        explicit ColorWriteBatch(DeviceManager* manager) : manager(manager) {}
+        ~ColorWriteBatch() { Commit(); }
+        ColorWriteBatch(const ColorWriteBatch&) = delete;
+        ColorWriteBatch& operator=(const ColorWriteBatch&) = delete;
+
+        bool SetDevice(int deviceIndex, RGBColor color);
+        bool SetZone(int deviceIndex, int zoneIndex, RGBColor color);
+        bool SetLED(int deviceIndex, int ledIndex, RGBColor color);
+
+        // Returns the number of devices updated
+        int Commit();
+
+    private:
+        DeviceHandle Resolve(int deviceIndex) const;
+        bool MarkWritten(const DeviceHandle& device, bool written);
+
+        DeviceManager* manager;
+        std::vector<DeviceHandle> touched;
+    };
+
+    // Name lookups through a hashed index, rebuilt once per controller list
+    // generation (GUI thread only). Return -1 when the name is unknown.
+    const DeviceNameIndex& GetNameIndex() const;
+    quint64 GetDeviceListGeneration() const { return RefreshControllers(); }
+    int FindDevice(const QString& name, Lightscape::DeviceType type) const;
+    int FindZone(int deviceIndex, const QString& name) const;
+    int FindLED(int deviceIndex, const QString& name) const;
+
+    // Frame output (used by the effect frame compositor)
+    bool GetZoneRange(int deviceIndex, int zoneIndex, unsigned int& startIndex, unsigned int& ledCount) const;
+    bool GetDeviceColors(int deviceIndex, std::vector<RGBColor>& colors) const;
+    bool ApplyDeviceColors(int deviceIndex, const std::vector<RGBColor>& colors, bool* skipped = nullptr);
+    bool GetZoneRange(const DeviceHandle& device, int zoneIndex, unsigned int& startIndex, unsigned int& ledCount) const;
+    bool GetDeviceColors(const DeviceHandle& device, std::vector<RGBColor>& colors) const;
+    bool ApplyDeviceColors(const DeviceHandle& device, const std::vector<RGBColor>& colors, bool* skipped = nullptr);
+
+    // Asynchronous frame output: the frame goes to the controller's output
+    // worker and the call returns at once. A frame still waiting there is
+    // replaced, not queued (returns true then).
+    bool SubmitDeviceColors(const DeviceHandle& device, const std::vector<RGBColor>& colors);
+    void FlushOutput();
+    std::vector<DeviceOutputPool::ControllerStatistics> GetOutputStatistics() const { return outputPool.GetStatistics(); }
+    void TakeOutputWriteTimes(std::vector<DeviceOutputPool::WriteTime>& times) const { outputPool.TakeWriteTimes(times); }
+    
+    // Delta output statistics (totals since the last reset)
+    quint64 GetSentUpdateCount() const { return sentUpdates.load(std::memory_order_relaxed); }
+    quint64 GetSkippedUpdateCount() const { return skippedUpdates.load(std::memory_order_relaxed); }
+    quint64 GetZoneUpdateCount() const { return zoneUpdates.load(std::memory_order_relaxed); }
+    void ResetOutputStatistics();
+
+    // Device updates and errors (any thread) are coalesced and reported at
+    // most once per notification interval: one notificationsReady() summary,
+    // then errorOccurred() once per distinct message. Widgets that refresh on
+    // their own timer can poll instead: keep the serial last seen and ask for
+    // the devices updated since.
+    void SetNotificationInterval(int milliseconds);
+    int GetNotificationInterval() const;
+    void FlushNotifications();
+    quint64 GetNotificationSerial() const { return notifier.GetSerial(); }
+    QList<int> GetDevicesUpdatedSince(quint64 serial) const { return notifier.GetUpdatedSince(serial); }
+    QString GetLastError() const { return notifier.GetLastError(); }
+
     // Non-RGB Device Methods
     unsigned int GetNonRGBDeviceCount() const;
     QString GetNonRGBDeviceName(unsigned int index) const;
@@ -69,7 +169,7 @@ public:
 
 signals:
     void deviceListChanged();
-    void deviceUpdated(int deviceIndex, Lightscape::DeviceType type);
+    void notificationsReady(const DeviceNotificationSummary& summary);
     void errorOccurred(const QString& error);
     void nonRGBDeviceAdded(NonRGBDevice* device);
     void nonRGBDeviceRemoved(const QString& deviceName);
@@ -83,12 +183,41 @@ private:
         bool isAssigned;
     };
 
+    std::unique_ptr<ControllerSource> ownedSource;
+    ControllerSource* controllerSource = nullptr;
     QList<NonRGBDevice*> nonRGBDevices;
     QMap<QPair<unsigned int, Lightscape::DeviceType>, DeviceAssignment> deviceAssignments;
     int currentDeviceIndex;
     QString currentSelectionName;
     Lightscape::DeviceType currentDeviceType;
-    mutable QString lastError;
+    mutable DeviceNameIndex nameIndex;
+    mutable DeviceNotifier notifier;
+    QTimer* notificationTimer = nullptr;
+
+    // One handle per RGB controller, in controller list order
+    mutable std::mutex controllerMutex;
+    mutable std::vector<DeviceHandle> controllerTable;
+    mutable std::atomic<quint64> controllerGeneration{0};   // written under controllerMutex
+    
+    // Last frame pushed to each controller, used to skip unchanged frames
+    struct SentFrame {
+        RGBController* controller = nullptr;
+        std::vector<RGBColor> colors;
+    };
+    QMap<int, SentFrame> lastSentColors;
+    mutable std::mutex outputMutex;
+    std::atomic<quint64> sentUpdates{0};
+    std::atomic<quint64> skippedUpdates{0};
+    std::atomic<quint64> zoneUpdates{0};
+
+    // Declared last: its workers write through this object until it is stopped
+    mutable DeviceOutputPool outputPool;
+    
+    void InitializeNotifications();
+    void NotifyDeviceUpdated(int deviceIndex) const;
+    void ScheduleNotifications() const;
+    quint64 RefreshControllersLocked(DeviceOutputPool::RetiredWorkers& retired) const;
+    bool ApplyQueuedColors(const DeviceHandle& device, const std::vector<RGBColor>& colors);
     bool ValidateZoneIndex(int deviceIndex, int zoneIndex) const;
     bool ValidateLEDIndex(int deviceIndex, int ledIndex) const;
     void SetError(const QString& error) const;
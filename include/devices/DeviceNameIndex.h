@@ -0,0 +1,54 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| DeviceNameIndex.h                                         |
+|                                                           |
+| Hashed device, zone and LED name lookups                  |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+#include <vector>
+#include "RGBController.h"
+
+/**
+ * Names of every RGB controller, zone and LED, converted to QString once and
+ * hashed. An index describes one generation of the controller list (see
+ * DeviceManager::RefreshControllers). Copies are cheap, so callers can keep
+ * an old generation around to translate indices after a hotplug.
+ *
+ * When names repeat, lookups return the first index, like a linear search.
+ */
+class DeviceNameIndex
+{
+public:
+    void Rebuild(const std::vector<RGBController*>& controllers, quint64 generation);
+    quint64 Generation() const { return generation; }
+
+    int FindDevice(const QString& name) const;
+    int FindZone(int deviceIndex, const QString& name) const;
+    int FindLED(int deviceIndex, const QString& name) const;
+
+    int DeviceCount() const { return devices.size(); }
+    QString DeviceName(int deviceIndex) const;
+    QString ZoneName(int deviceIndex, int zoneIndex) const;
+    QString LEDName(int deviceIndex, int ledIndex) const;
+
+private:
+    struct DeviceNames {
+        QString name;
+        QStringList zones;
+        QStringList leds;
+        QHash<QString, int> zoneIndices;
+        QHash<QString, int> ledIndices;
+    };
+
+    quint64 generation = 0;
+    QVector<DeviceNames> devices;
+    QHash<QString, int> deviceIndices;
+};
@@ -0,0 +1,73 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| DeviceNotifier.h                                          |
+|                                                           |
+| Coalesces device updates and errors between UI refreshes  |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QList>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/**
+ * Everything DeviceManager reported since the previous summary.
+ */
+struct DeviceNotificationSummary
+{
+    quint64 serial = 0;             // notifier serial the summary runs up to
+    QList<int> updatedDevices;      // RGB device indices, ascending
+    quint64 updateCount = 0;        // device updates folded into this summary
+    QStringList errors;             // distinct messages, first seen first
+    QList<int> errorCounts;         // times each message was reported
+    int droppedErrors = 0;          // reports past the distinct-message limit
+
+    bool IsEmpty() const { return updatedDevices.isEmpty() && errors.isEmpty() && droppedErrors == 0; }
+};
+
+Q_DECLARE_METATYPE(DeviceNotificationSummary)
+
+/**
+ * Collects device updates and errors from any thread. Every update stamps its
+ * device with the next serial, so a poller keeps the serial it last saw and
+ * asks for the devices updated since; nothing is cleared by reading. Errors
+ * are counted per distinct message until the next TakeSummary().
+ */
+class DeviceNotifier
+{
+public:
+    static const int MaxDistinctErrors = 32;
+
+    // Both return true for the first report since the last TakeSummary(),
+    // which is when the owner schedules the next one
+    bool MarkUpdated(int deviceIndex);
+    bool ReportError(const QString& error);
+
+    DeviceNotificationSummary TakeSummary();
+
+    quint64 GetSerial() const { return serial.load(std::memory_order_acquire); }
+    QList<int> GetUpdatedSince(quint64 since) const;
+    QString GetLastError() const;
+
+private:
+    QList<int> UpdatedSinceLocked(quint64 since) const;
+    bool MarkPendingLocked();
+
+    mutable std::mutex mutex;
+    std::atomic<quint64> serial{0};
+    std::vector<quint64> deviceSerials;     // serial of each device's last update, 0 = never
+
+    bool pending = false;
+    quint64 summarySerial = 0;
+    quint64 pendingUpdates = 0;
+    QStringList pendingErrors;
+    QList<int> pendingErrorCounts;
+    int droppedErrors = 0;
+    QString lastError;
+};
@@ -0,0 +1,134 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| DeviceOutputPool.h                                        |
+|                                                           |
+| Per-controller output threads with latest-frame mailboxes |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QtGlobal>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RGBController.h"
+#include "devices/DeviceHandle.h"
+
+/**
+ * One output thread per RGB controller, so a controller that blocks in
+ * UpdateLEDs (SMBus RAM sticks, slow USB) only slows itself down.
+ *
+ * Each worker has a single-slot mailbox. Submit() drops the newest frame in
+ * and returns at once; a frame the worker has not picked up yet is
+ * overwritten and counted as dropped. Workers start on their controller's
+ * first frame and stop when the controller leaves the list (Retain).
+ */
+class DeviceOutputPool
+{
+    struct Worker;
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Returns true when the frame reached the controller, false when it was skipped
+    using Writer = std::function<bool(const DeviceHandle&, const std::vector<RGBColor>&)>;
+
+    struct ControllerStatistics
+    {
+        RGBController* controller = nullptr;
+        int deviceIndex = -1;    // as of the last submitted frame
+        quint64 submitted = 0;
+        quint64 written = 0;
+        quint64 dropped = 0;     // overwritten in the mailbox before they were written
+        double fps = 0.0;        // writes per second over the last second
+        double writeMs = 0.0;    // average write time over the same window
+    };
+
+    // One frame that reached a controller and how long the write took
+    struct WriteTime
+    {
+        int deviceIndex = -1;
+        Clock::duration elapsed = Clock::duration::zero();
+    };
+
+    explicit DeviceOutputPool(Writer writer);
+    ~DeviceOutputPool();
+
+    DeviceOutputPool(const DeviceOutputPool&) = delete;
+    DeviceOutputPool& operator=(const DeviceOutputPool&) = delete;
+
+    // Returns true when an unwritten frame was replaced
+    bool Submit(const DeviceHandle& device, const std::vector<RGBColor>& colors);
+
+    // Workers taken out of the pool by Retain(). Destroying this joins them, so
+    // declare it ahead of any lock held around Retain() and the join runs unlocked.
+    class RetiredWorkers
+    {
+    public:
+        RetiredWorkers() = default;
+        ~RetiredWorkers();
+
+        RetiredWorkers(const RetiredWorkers&) = delete;
+        RetiredWorkers& operator=(const RetiredWorkers&) = delete;
+
+    private:
+        friend class DeviceOutputPool;
+        std::vector<std::shared_ptr<Worker>> workers;
+    };
+
+    // Moves the workers of controllers not in 'devices' into 'retired'. Their pending
+    // frames are discarded at once and they write nothing after the current frame.
+    void Retain(const std::vector<DeviceHandle>& devices, RetiredWorkers& retired);
+
+    // Blocks until every submitted frame has been written
+    void Flush();
+
+    // Writes the pending frames, then stops every worker
+    void Stop();
+
+    std::vector<ControllerStatistics> GetStatistics() const;
+    void ResetStatistics();
+
+    // Appends the writes finished since the last call, so the render thread can
+    // report real per-controller times. Each worker keeps only the latest few.
+    void TakeWriteTimes(std::vector<WriteTime>& times);
+
+private:
+
+    struct Worker
+    {
+        std::thread thread;
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+
+        bool stopping = false;
+        bool hasPending = false;
+        bool writing = false;
+        DeviceHandle pendingDevice;
+        std::vector<RGBColor> pending;
+
+        ControllerStatistics stats;
+        Clock::time_point windowStart;
+        quint64 windowWrites = 0;
+        Clock::duration windowWriteTime = Clock::duration::zero();
+        std::vector<WriteTime> unreported;
+    };
+
+    void Run(Worker* worker);
+    static void SignalStop(Worker* worker, bool discardPending);
+    static void JoinWorker(Worker* worker);
+    static void StopWorker(Worker* worker, bool discardPending);
+
+    Writer writer;
+    mutable std::mutex workersMutex;
+    // Shared so Submit() and Flush() can use a worker outside workersMutex
+    // while Retain() or Stop() takes it out of the map
+    std::map<RGBController*, std::shared_ptr<Worker>> workers;
+};
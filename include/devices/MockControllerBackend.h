@@ -0,0 +1,172 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| MockControllerBackend.h                                   |
+|                                                           |
+| In-process stand-in controllers with simulated latency    |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QtGlobal>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include "RGBController.h"
+#include "devices/ControllerSource.h"
+
+enum class MockTopology
+{
+    Linear,     // 'zones' linear zones of 'width' LEDs
+    Matrix,     // one width x height matrix zone
+    Single      // 'zones' single-LED zones
+};
+
+struct MockControllerSpec
+{
+    std::string name;
+    MockTopology topology = MockTopology::Linear;
+    int zones = 1;
+    int width = 32;
+    int height = 1;
+
+    // Every update sleeps latency plus a uniform 0..jitter extra
+    std::chrono::microseconds latency{0};
+    std::chrono::microseconds jitter{0};
+
+    int GetLEDCount() const;
+};
+
+/**
+ * Every update the mock controllers received, shared by one backend. Keeps
+ * totals for the whole run and the most recent entries for inspection, in a
+ * ring allocated up front so recording never allocates once every controller
+ * has written.
+ */
+class MockWriteLog
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Kind { Device, Zone, SingleLED };
+
+    struct Entry
+    {
+        int controllerId = -1;
+        Kind kind = Kind::Device;
+        int target = -1;        // zone or LED index, -1 for whole-device updates
+        Clock::time_point start;
+        Clock::duration duration = Clock::duration::zero();
+    };
+
+    struct Totals
+    {
+        quint64 writes = 0;
+        Clock::duration busy = Clock::duration::zero();
+        Clock::duration longest = Clock::duration::zero();
+    };
+
+    explicit MockWriteLog(size_t capacity = 4096);
+
+    void Record(const Entry& entry);
+    void Clear();
+
+    std::vector<Entry> GetEntries() const;
+    Totals GetTotals() const;
+    Totals GetTotals(int controllerId) const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<Entry> entries;     // ring of 'capacity' slots
+    size_t next = 0;                // slot the next entry goes to
+    size_t count = 0;
+    std::vector<Totals> controllerTotals;
+    Totals totals;
+};
+
+/**
+ * Synthetic controller with a fixed topology and a Direct mode. Updates are
+ * never sent anywhere; each one sleeps for the spec's latency model, the way
+ * a slow bus blocks the caller, and is recorded in the write log.
+ */
+class MockController : public RGBController
+{
+public:
+    MockController(int controllerId, const MockControllerSpec& spec, MockWriteLog* log);
+    ~MockController() override;
+
+    void SetupZones() override {}
+    void ResizeZone(int /*zone*/, int /*new_size*/) override {}
+    void DeviceUpdateLEDs() override;
+    void UpdateZoneLEDs(int zone) override;
+    void UpdateSingleLED(int led) override;
+    void DeviceUpdateMode() override {}
+
+    int GetControllerId() const { return controllerId; }
+    const MockControllerSpec& GetSpec() const { return spec; }
+    quint64 GetUpdateCount() const;
+
+    // Takes effect from the next update; callable while updates are running
+    void SetLatency(std::chrono::microseconds latency, std::chrono::microseconds jitter);
+
+private:
+    void Simulate(MockWriteLog::Kind kind, int target);
+
+    int controllerId;
+    MockControllerSpec spec;
+    MockWriteLog* log;
+
+    mutable std::mutex latencyMutex;
+    std::mt19937 random;
+    quint64 updateCount = 0;
+};
+
+/**
+ * Controller list made of MockControllers, in spec order. Jitter is seeded
+ * from the controller id, so the same specs give the same delays every run.
+ *
+ * Specs can be written as text (ParseSpecs), e.g. for the plugin's
+ * LIGHTSCAPE_MOCK_DEVICES variable or the bench's --devices option:
+ *
+ *     6*linear:4x32, matrix:22x6@8~4, single:4@30
+ *
+ * Entries are [count*]topology[:size][@latency[~jitter]], sizes are ZONESxLEDS
+ * for linear, WxH for matrix and ZONES for single, times are milliseconds.
+ */
+class MockControllerBackend : public ControllerSource
+{
+public:
+    MockControllerBackend();
+    explicit MockControllerBackend(const std::vector<MockControllerSpec>& specs);
+    ~MockControllerBackend() override;
+
+    MockControllerBackend(const MockControllerBackend&) = delete;
+    MockControllerBackend& operator=(const MockControllerBackend&) = delete;
+
+    static bool ParseSpecs(const std::string& text, std::vector<MockControllerSpec>& specs,
+                           std::string* error = nullptr);
+
+    std::vector<RGBController*>& GetRGBControllers() override { return controllers; }
+    std::unique_lock<std::mutex> LockControllers() override { return std::unique_lock<std::mutex>(controllersMutex); }
+
+    // Simulates hotplug; safe while DeviceManager renders and writes on other
+    // threads. The caller owns a removed controller and must keep it alive
+    // until DeviceManager has refreshed its controller list.
+    MockController* AddController(const MockControllerSpec& spec);
+    std::unique_ptr<MockController> RemoveController(int index);
+
+    MockController* GetController(int index) const;
+    size_t GetTotalLEDCount() const;
+
+    MockWriteLog& GetWriteLog() { return writeLog; }
+    const MockWriteLog& GetWriteLog() const { return writeLog; }
+
+private:
+    MockWriteLog writeLog;
+    mutable std::mutex controllersMutex;
+    std::vector<RGBController*> controllers;
+    int nextControllerId = 0;
+};
@@ -3,8 +3,15 @@
 #include <QWidget>
 #include <QJsonObject>
 #include <vector>
+#include <memory>
+#include <atomic>
 #include "grid/SpatialGrid.h"
 #include "effects/EffectInfo.h"
+#include "effects/PositionBatch.h"
+#include "effects/EffectParameters.h"
+#include "core/FrameArena.h"
+#include "core/SeqLock.h"
+#include "core/Span.h"
 #include "core/Types.h"
 
 // Forward declarations
@@ -13,6 +20,7 @@ class DeviceManager;
 namespace Lightscape {
 
 class ControllerZone; // For OpenRGBEffectsPlugin-style interface
+class FrameCompositor;
 
 class BaseEffect : public QWidget
 {
@@ -31,12 +39,27 @@ public:
     // Spatial color calculation - this is key for grid integration
     virtual RGBColor getColorForPosition(const GridPosition& pos, float time) = 0;
     
-    // Apply effect to devices
+    // Batch color calculation - fills colors[0..positions.size()) in one call.
+    // Read settings from 'params' only, so the call is safe from any thread.
+    // The default falls back to getColorForPosition; override with a tight loop.
+    virtual void getColorsForPositions(const PositionBatch& positions, float time,
+                                       const EffectParameters& params, RGBColor* colors);
+    
+    // Colors as they are sent to the devices: the batch above with brightness
+    // applied once. Used by the render path and the previews.
+    void getOutputColors(const PositionBatch& positions, float time,
+                         const EffectParameters& params, RGBColor* colors);
+    
+    // Apply effect to devices (renders and flushes a frame immediately).
+    // Only for effects that are not running on the render thread.
     virtual void applyToDevices(const QList<DeviceInfo>& devices);
     
+    // Render this effect's colors into a shared frame without touching the hardware
+    virtual void renderToCompositor(ConstSpan<DeviceInfo> devices, FrameCompositor& compositor);
+    
     // OpenRGBEffectsPlugin-style interface methods
-    virtual void StepEffect(std::vector<ControllerZone*> zones);
-    virtual void OnControllerZonesListChanged(std::vector<ControllerZone*> zones);
+    virtual void StepEffect(ConstSpan<ControllerZone*> zones);
+    virtual void OnControllerZonesListChanged(ConstSpan<ControllerZone*> zones);
     
     // Settings management
     virtual void loadSettings(const QJsonObject& json);
@@ -46,28 +69,32 @@ public:
     void setEnabled(bool enabled) { isEnabled = enabled; }
     bool getEnabled() const { return isEnabled; }
     
-    // Common effect properties
-    void setSpeed(int value) { speed = value; }
+    // Common effect properties (UI thread; each setter publishes to the renderer)
+    void setSpeed(int value) { speed = value; publishParameters(); }
     int getSpeed() const { return speed; }
     
-    void setBrightness(int value) { brightness = value; }
+    void setBrightness(int value) { brightness = value; publishParameters(); }
     int getBrightness() const { return brightness; }
     
-    void setReferencePoint(const GridPosition& pos) { referencePoint = pos; }
+    void setReferencePoint(const GridPosition& pos) { referencePoint = pos; publishParameters(); }
     GridPosition getReferencePoint() const { return referencePoint; }
     
-    void setColors(const QList<RGBColor>& colors) { userColors = colors; }
+    // Keeps at most EffectParameters::MaxColors, logging a warning when it drops any
+    void setColors(const QList<RGBColor>& colors);
     QList<RGBColor> getColors() const { return userColors; }
     
-    void setRandomColors(bool value) { randomColorsEnabled = value; }
+    void setRandomColors(bool value) { randomColorsEnabled = value; publishParameters(); }
     bool getRandomColors() const { return randomColorsEnabled; }
     
     // Get the FPS setting
-    void setFPS(unsigned int value) { fps = value; }
+    void setFPS(unsigned int value) { fps = value; publishParameters(); }
     unsigned int getFPS() const { return fps; }
     
-    // Get the internal time for consistent animation timing
-    float getInternalTime() const { return time; }
+    // Lock-free snapshot of the last published settings (any thread)
+    EffectParameters parameters() const { return _publishedParameters.load(); }
+    
+    // Get the internal time for consistent animation timing (any thread)
+    float getInternalTime() const { return _sharedTime.load(std::memory_order_relaxed); }
     
     // Each effect must provide static info
     static EffectInfo GetStaticInfo() { return EffectInfo(); }
@@ -79,10 +106,11 @@ signals:
 protected:
     ::DeviceManager* deviceManager = nullptr;
     ::SpatialGrid* spatialGrid = nullptr;
-    bool isEnabled = false;
-    float time = 0.0f;
+    std::atomic<bool> isEnabled{false};
+    float time = 0.0f;  // render thread
     
-    // Common effect properties
+    // Common effect properties - owned by the UI thread, call publishParameters()
+    // after changing them directly. The render thread reads frameParameters instead.
     int speed = 50;
     int brightness = 100;
     GridPosition referencePoint{0, 0, 0};
@@ -90,15 +118,45 @@ protected:
     bool randomColorsEnabled = false;
     
     // Helper methods for OpenRGBEffectsPlugin-style interface
-    void processSpatialZones(std::vector<ControllerZone*> zones, float time);
-    void processNonSpatialZones(std::vector<ControllerZone*> zones, float time);
+    void processSpatialZones(ConstSpan<ControllerZone*> zones, float time);
+    void processNonSpatialZones(ConstSpan<ControllerZone*> zones, float time);
     
     // FPS setting
     unsigned int fps = 60;
     
+    // Settings snapshot taken by update() at the start of every frame (render thread)
+    EffectParameters frameParameters;
+    void publishParameters();
+    void clampUserColors();
+    
+    // Scratch buffers for batch evaluation on the render thread (reused every frame)
+    PositionBatch frameBatch;
+    std::vector<RGBColor> frameColors;
+    void evaluateFrameBatch(float time);
+    
+    // Per-frame temporaries (render thread), reset by update(); spans taken
+    // from it are only valid until the effect's next update()
+    FrameArena frameArena;
+    
+    // Held for the whole frame, so an invalidation on the UI thread can't free it
+    std::shared_ptr<const SpatialField> frameField;
+    
     // Helper methods for derived classes
     float calculateDistance(const GridPosition& pos1, const GridPosition& pos2) const;
+    
+    // Cached distance/angle tables around a reference point; fetch once per batch and
+    // hold the pointer while reading. Returns null when there is no grid.
+    std::shared_ptr<const SpatialField> getReferenceField(const GridPosition& reference) const;
+    
+    // The field for this frame's reference point, fetched by update() (render thread).
+    // Radial effects index its tables instead of calling sqrt/atan2 per position;
+    // null when there is no grid.
+    const SpatialField* getFrameField() const { return frameField.get(); }
     RGBColor applyBrightness(const RGBColor& color, float brightnessFactor) const;
+    
+private:
+    SeqLock<EffectParameters> _publishedParameters;
+    std::atomic<float> _sharedTime{0.0f};
 };
 
 } // namespace Lightscape
\ No newline at end of file
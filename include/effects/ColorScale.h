@@ -0,0 +1,38 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| ColorScale.h                                              |
+|                                                           |
+| Fixed-point brightness scaling for RGBColor values        |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "RGBController.h"
+
+namespace Lightscape {
+
+/**
+ * Brightness is an 8.8 fixed-point factor (256 = unchanged) derived from a
+ * 0-100 percentage. Every path below computes channel * factor >> 8, so the
+ * table lookup, the packed scalar path and the SIMD path give identical
+ * results. Effects produce full-brightness colors; BaseEffect scales each
+ * frame once, right before it is written out.
+ */
+
+// 8.8 factor for a 0-100 brightness (clamped)
+uint32_t brightnessFactor(int percent);
+
+// Precomputed 256-entry channel table for a 0-100 brightness (clamped)
+const uint8_t* brightnessTable(int percent);
+
+// One color through the table
+RGBColor scaleColor(RGBColor color, int percent);
+
+// 'count' colors, eight or four at a time with SSE2 where available.
+// 'src' and 'dst' may be the same buffer.
+void scaleColors(const RGBColor* src, RGBColor* dst, size_t count, int percent);
+
+} // namespace Lightscape
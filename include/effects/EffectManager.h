@@ -9,16 +9,21 @@
 #pragma once
 
 #include <QObject>
-#include <QTimer>
-#include <QElapsedTimer>
 #include <QList>
 #include <QMap>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 #include "effects/BaseEffect.h"
 #include "effects/SpatialControllerZone.h"
 #include "effects/PreviewRenderer.h"
+#include "effects/FrameCompositor.h"
+#include "effects/FrameScheduler.h"
+#include "effects/FrameStatistics.h"
+#include "effects/RenderSnapshot.h"
+#include "devices/DeviceOutputPool.h"
 
 // Forward declarations
 class DeviceManager;
@@ -46,7 +51,12 @@ public:
     bool startEffect(const QString& effectId, BaseEffect* existingEffect);
     void stopEffect(BaseEffect* effect);
     bool isEffectRunning(BaseEffect* effect) const;
-    QList<BaseEffect*> getRunningEffects() const;
+    QList<BaseEffect*> getRunningEffects() const; // in layer order, bottom first
+    
+    // Layer stack - each running effect is one layer, blended bottom to top
+    void setEffectLayer(BaseEffect* effect, const LayerSettings& settings);
+    LayerSettings getEffectLayer(BaseEffect* effect) const;
+    void moveEffectLayer(BaseEffect* effect, int position);
     
     // Device selection
     void setActiveDevices(const QList<DeviceInfo>& devices);
@@ -73,6 +83,20 @@ public:
     void setPreviewRenderer(PreviewRenderer* renderer);
     void setReducedFps(bool reduced);
     
+    // Render loop statistics
+    bool isRenderThreadRunning() const { return _renderThreadRunning; }
+    uint64_t getRenderedFrameCount() const { return _scheduler.getFrameCount(); }
+    uint64_t getDroppedFrameCount() const { return _scheduler.getDroppedFrameCount(); }
+    int getLastFrameSentCount() const { return _compositor.getLastFrameSentCount(); }
+    int getLastFrameSkippedCount() const { return _compositor.getLastFrameSkippedCount(); }
+    
+    // Per-stage timing percentiles and frame-miss counters
+    FrameStatistics::Snapshot getFrameStatistics() const { return _statistics.snapshot(); }
+    void resetFrameStatistics();
+    
+    // Achieved rate and dropped frames of each controller's output worker
+    std::vector<DeviceOutputPool::ControllerStatistics> getOutputStatistics() const;
+    
     // Preview zone management
     void addPreview(BaseEffect* effect, ControllerZone* preview);
     void removePreview(BaseEffect* effect);
@@ -88,9 +112,6 @@ signals:
     void effectStopped(BaseEffect* effect);
     void previewUpdated();
 
-private slots:
-    void updateEffect();
-
 private:
     EffectManager();
     ~EffectManager();
@@ -99,36 +120,64 @@ private:
     EffectManager(const EffectManager&) = delete;
     EffectManager& operator=(const EffectManager&) = delete;
     
-    // Private methods
-    void effectThreadFunction(BaseEffect* effect);
+    // Render thread
+    void startRenderThread();
+    void stopRenderThread();
+    void renderThreadFunction();
+    void renderFrame(float deltaTime);
+    void bindDevices();
+    void publishSnapshot();
+    void acquireSnapshot();
+    void synchronizeRenderThread();
     void updateDevicePositions();
     
-    QTimer* _updateTimer;
+    // UI thread state - what the rest of the plugin queries
     ::DeviceManager* _deviceManager = nullptr;
     ::SpatialGrid* _spatialGrid = nullptr;
     BaseEffect* _activeEffect = nullptr;  // Still keep for backwards compatibility
     QString _currentEffectId;
     QList<DeviceInfo> _activeDevices;
     bool _isRunning = false;
-    bool _previewEnabled = true;
-    int _updateInterval = 33; // ~30 FPS
-    QElapsedTimer _frameTimer;
+    std::atomic<bool> _previewEnabled{true};
+    std::atomic<int> _updateInterval{33}; // ~30 FPS
     
     // Multiple effect support
     QMap<BaseEffect*, bool> _runningEffects;
     QMap<BaseEffect*, QList<DeviceInfo>> _effectDevices;
+    QList<BaseEffect*> _layerOrder;
+    QMap<BaseEffect*, LayerSettings> _layerSettings;
     
     // Preview
     PreviewRenderer* _previewRenderer = nullptr;
+    QMap<BaseEffect*, ControllerZone*> _previews;
     
     // Zone tracking
     std::vector<ControllerZone*> _activeZones;
     std::vector<SpatialControllerZone*> _spatialZones;
-    QMap<BaseEffect*, ControllerZone*> _previews;
+    
+    // Controllers pinned by the last device list change (bindDevices)
+    quint64 _deviceBinding = 0;
+    std::shared_ptr<const std::vector<DeviceHandle>> _deviceHandles;
+    
+    // Published render configuration, only accessed through std::atomic_load/store.
+    // _publishedVersion lets the render thread see "unchanged" with one load.
+    std::shared_ptr<const RenderSnapshot> _publishedSnapshot;
+    std::atomic<quint64> _publishedVersion{0};
+    quint64 _snapshotVersion = 0;
+    
+    // Render thread state - only touched while holding _frameMutex
+    std::shared_ptr<const RenderSnapshot> _renderSnapshot;
+    quint64 _boundDeviceBinding = 0;
+    
+    // Frame output - every effect renders here, each controller is flushed once per frame
+    FrameCompositor _compositor;
     
     // Thread management
-    std::map<BaseEffect*, std::thread*> _effectThreads;
-    std::mutex _mutex;
+    FrameScheduler _scheduler;
+    FrameStatistics _statistics;
+    std::thread _renderThread;
+    std::atomic<bool> _renderThreadRunning{false};
+    std::mutex _frameMutex;
 };
 
 } // namespace Lightscape
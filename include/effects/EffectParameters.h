@@ -0,0 +1,51 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| EffectParameters.h                                        |
+|                                                           |
+| Per-effect parameter block shared with the render thread  |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QList>
+#include <algorithm>
+#include <array>
+#include "RGBController.h"
+#include "grid/GridTypes.h"
+
+namespace Lightscape {
+
+/**
+ * Everything an effect needs to render a frame, as one plain value. The UI
+ * publishes a new block whenever a setting changes and the render thread
+ * takes one snapshot per frame, so a frame never sees half an update.
+ * Colors live in a fixed array because a QList cannot be copied lock-free.
+ */
+struct EffectParameters
+{
+    // Largest palette an effect renders. BaseEffect::setColors and loadSettings
+    // cut longer lists down to this with a warning, so what the UI shows and
+    // saves is what the renderer uses; setColors() below only guards the array.
+    static constexpr int MaxColors = 16;
+
+    int speed = 50;
+    int brightness = 100;
+    unsigned int fps = 60;
+    bool randomColors = false;
+    GridPosition referencePoint{0, 0, 0};
+    int colorCount = 0;
+    std::array<RGBColor, MaxColors> colors{};
+
+    void setColors(const QList<RGBColor>& list)
+    {
+        colorCount = std::min(static_cast<int>(list.size()), MaxColors);
+        for (int i = 0; i < colorCount; i++) {
+            colors[i] = list[i];
+        }
+    }
+
+    bool hasColors() const { return colorCount > 0; }
+};
+
+} // namespace Lightscape
@@ -0,0 +1,153 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameCompositor.h                                         |
+|                                                           |
+| Per-controller frame buffer for effect output             |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QMap>
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+#include "RGBController.h"
+#include "devices/DeviceHandle.h"
+#include "devices/DeviceOutputPool.h"
+#include "effects/LayerBlend.h"
+
+// Forward declarations
+class DeviceManager;
+
+namespace Lightscape {
+
+class FrameStatistics;
+
+/**
+ * FrameCompositor collects the output of every running effect for one frame
+ * into a color buffer per controller, then pushes each touched controller to
+ * the hardware exactly once in flush().
+ *
+ * Typical frame:
+ *   compositor.beginFrame();
+ *   compositor.beginLayer(settings);                    // for each effect,
+ *   effect->renderToCompositor(devices, compositor);   // bottom layer first
+ *   compositor.endLayer();
+ *   compositor.flush();
+ *
+ * Inside a layer, writes go to a per-controller layer buffer and only the
+ * LEDs the layer actually wrote are blended down in endLayer(). Writes
+ * outside a layer go straight into the frame (last writer wins).
+ *
+ * Every frame starts from the colors a controller showed before the
+ * compositor first wrote to it, never from its own previous output, so
+ * blend modes and opacity don't feed back from one frame into the next.
+ * LEDs the compositor has never changed follow the controller, so colors
+ * set from outside stay visible. clear() takes a new snapshot.
+ *
+ * Device indices are resolved to DeviceHandles once per controller list
+ * generation, in beginFrame(), so writes only check LED and zone bounds.
+ */
+class FrameCompositor
+{
+public:
+    explicit FrameCompositor(::DeviceManager* deviceManager = nullptr);
+    ~FrameCompositor() = default;
+
+    void setDeviceManager(::DeviceManager* deviceManager);
+    ::DeviceManager* getDeviceManager() const { return _deviceManager; }
+
+    // Pins device indices to the controllers they meant when the device lists
+    // were built. After a rescan, writes follow those controllers to their new
+    // indices (or are dropped if they are gone) until the next bind. Unbound,
+    // indices always refer to the current controller list.
+    void bindDevices(const std::vector<DeviceHandle>& devices);
+
+    // Optional per-controller flush timing. With async output these are the
+    // workers' UpdateLEDs times, collected on the next flush.
+    void setStatistics(FrameStatistics* statistics) { _statistics = statistics; }
+
+    // Hand flushed frames to the per-controller output workers instead of
+    // writing them on this thread (DeviceManager::SubmitDeviceColors)
+    void setAsyncOutput(bool async) { _asyncOutput = async; }
+    bool isAsyncOutput() const { return _asyncOutput; }
+
+    // Frame lifecycle
+    void beginFrame();
+    int flush();
+    void clear();
+
+    // Layer lifecycle
+    void beginLayer(const LayerSettings& settings);
+    void endLayer();
+    bool isInLayer() const { return _inLayer; }
+
+    // Color writes - these only touch the frame buffer, never the hardware
+    bool setLED(int deviceIndex, int ledIndex, RGBColor color);
+    bool setZone(int deviceIndex, int zoneIndex, RGBColor color);
+    bool setDevice(int deviceIndex, RGBColor color);
+
+    // Frame state
+    bool hasPendingOutput() const;
+    int getTouchedControllerCount() const;
+
+    // Result of the last flush: controllers pushed vs. skipped because nothing changed.
+    // With async output, "sent" counts frames handed to the workers; they do the skipping.
+    int getLastFrameSentCount() const { return _lastFrameSent.load(std::memory_order_relaxed); }
+    int getLastFrameSkippedCount() const { return _lastFrameSkipped.load(std::memory_order_relaxed); }
+
+private:
+    struct ControllerBuffer {
+        DeviceHandle device;
+        std::vector<RGBColor> colors;
+        bool touched = false;
+
+        // Current layer: its colors and which LEDs it wrote
+        std::vector<RGBColor> layerColors;
+        std::vector<uint8_t> layerMask;
+        bool layerTouched = false;
+    };
+
+    // What a controller showed before its first frame, the base every frame starts from
+    struct BaseColors {
+        DeviceHandle device;
+        std::string name;
+        std::string location;
+        std::vector<RGBColor> colors;
+
+        // LEDs a flushed frame set to something other than the base. The others
+        // are refreshed from the controller, so outside changes are picked up.
+        std::vector<uint8_t> written;
+    };
+
+    void refreshDevices();
+    void rebindBaseColors(quint64 generation);
+    bool loadBaseColors(const DeviceHandle& device, BaseColors& base);
+    void markWrittenColors(const ControllerBuffer& buffer);
+    ControllerBuffer* acquireBuffer(int deviceIndex);
+
+    // Where writes go: the layer buffer inside a layer, the frame otherwise
+    RGBColor* acquireTarget(int deviceIndex, size_t& size, uint8_t*& mask);
+
+    ::DeviceManager* _deviceManager = nullptr;
+    FrameStatistics* _statistics = nullptr;
+    bool _asyncOutput = false;
+    QMap<int, ControllerBuffer> _buffers;
+
+    // Keyed by controller index and only valid for the handle's generation
+    std::map<int, BaseColors> _baseColors;
+    quint64 _baseGeneration = 0;
+    std::vector<RGBColor> _currentColors;
+    std::vector<DeviceOutputPool::WriteTime> _writeTimes;
+    std::vector<DeviceHandle> _devices;
+    bool _devicesBound = false;
+    quint64 _devicesGeneration = 0;
+    LayerSettings _layerSettings;
+    bool _inLayer = false;
+    std::atomic<int> _lastFrameSent{0};
+    std::atomic<int> _lastFrameSkipped{0};
+};
+
+} // namespace Lightscape
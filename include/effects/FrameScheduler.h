@@ -0,0 +1,57 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameScheduler.h                                          |
+|                                                           |
+| Fixed-timestep frame pacing for the render thread         |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Lightscape {
+
+/**
+ * FrameScheduler paces the render loop against absolute deadlines
+ * (start + n * interval), so sleep jitter never accumulates into drift.
+ * When the loop falls more than a frame behind, the missed deadlines are
+ * counted as dropped and skipped rather than rendered back-to-back.
+ *
+ * Only the render thread calls reset/setInterval/waitForNextFrame; the
+ * counters may be read from any thread.
+ */
+class FrameScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    FrameScheduler();
+
+    // Scheduling (render thread only)
+    void setInterval(std::chrono::microseconds interval);
+    std::chrono::microseconds getInterval() const { return _interval; }
+    void reset();
+
+    // Blocks until the next deadline, returns the simulated time step in seconds
+    float waitForNextFrame();
+
+    // Statistics (any thread)
+    uint64_t getFrameCount() const { return _frameCount.load(std::memory_order_relaxed); }
+    uint64_t getDroppedFrameCount() const { return _droppedFrames.load(std::memory_order_relaxed); }
+    void resetStatistics();
+
+private:
+    std::chrono::microseconds _interval;
+    Clock::time_point _nextDeadline;
+
+    std::atomic<uint64_t> _frameCount;
+    std::atomic<uint64_t> _droppedFrames;
+
+    // Sleep until this close to the deadline, then yield-spin for accuracy
+    static constexpr std::chrono::microseconds SpinWindow{1000};
+};
+
+} // namespace Lightscape
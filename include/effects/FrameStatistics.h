@@ -0,0 +1,123 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameStatistics.h                                         |
+|                                                           |
+| Rolling per-stage frame timing for the render thread      |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QMap>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Lightscape {
+
+// Stages of one render frame, in execution order
+enum class FrameStage {
+    EffectUpdate,       // BaseEffect::update for every running effect
+    ColorEvaluation,    // Effects computing colors into their layers
+    Compositing,        // Blending layers into the frame
+    DeviceFlush,        // Render thread time pushing the frame out (only the hand-off with async output)
+    Preview,            // Preview zones and repaint requests
+    Total,              // Whole frame, excluding the pacing sleep
+    Count
+};
+
+const char* frameStageName(FrameStage stage);
+
+// Percentiles over the samples currently in the window, in microseconds
+struct TimingSummary {
+    uint32_t p50 = 0;
+    uint32_t p95 = 0;
+    uint32_t p99 = 0;
+    uint32_t max = 0;
+    int samples = 0;
+};
+
+/**
+ * Fixed-size ring of the most recent samples. Recording is a single store;
+ * percentiles are only computed when someone asks for them.
+ */
+class TimingWindow
+{
+public:
+    static constexpr int Capacity = 512;
+
+    void record(uint32_t microseconds);
+    TimingSummary summarize() const;
+    void clear();
+
+private:
+    std::array<uint32_t, Capacity> _samples{};
+    int _next = 0;
+    int _count = 0;
+};
+
+/**
+ * FrameStatistics collects stage timings on the render thread and hands
+ * consistent snapshots to the UI. The render thread accumulates one frame
+ * locally and commits it with a single short lock in endFrame().
+ */
+class FrameStatistics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Snapshot {
+        std::array<TimingSummary, static_cast<int>(FrameStage::Count)> stages;
+        QMap<int, TimingSummary> controllerFlush; // UpdateLEDs time, keyed by device index
+        uint64_t frames = 0;
+        uint64_t overruns = 0;  // frames whose work took longer than the frame budget
+        uint64_t dropped = 0;   // deadlines skipped by the scheduler
+        uint32_t budget = 0;    // frame budget in microseconds
+    };
+
+    // Render thread
+    void beginFrame(std::chrono::microseconds budget);
+    void addStageTime(FrameStage stage, Clock::duration elapsed);
+    void addControllerFlushTime(int deviceIndex, Clock::duration elapsed);
+    void endFrame(uint64_t droppedFrames);
+
+    // Any thread
+    Snapshot snapshot() const;
+    void reset();
+
+private:
+    // Current frame, render thread only
+    std::array<Clock::duration, static_cast<int>(FrameStage::Count)> _frameStages{};
+    std::vector<std::pair<int, uint32_t>> _frameFlushes;
+    Clock::time_point _frameStart;
+    uint32_t _frameBudget = 0;
+
+    // Committed history, guarded by _mutex
+    mutable std::mutex _mutex;
+    std::array<TimingWindow, static_cast<int>(FrameStage::Count)> _stages;
+    QMap<int, TimingWindow> _controllerFlush;
+    uint64_t _frames = 0;
+    uint64_t _overruns = 0;
+    uint64_t _dropped = 0;
+    uint32_t _budget = 0;
+};
+
+/**
+ * Adds the time from construction to destruction to a stage.
+ */
+class ScopedStageTimer
+{
+public:
+    ScopedStageTimer(FrameStatistics& statistics, FrameStage stage)
+        : _statistics(statistics), _stage(stage), _start(FrameStatistics::Clock::now()) {}
+    ~ScopedStageTimer() { _statistics.addStageTime(_stage, FrameStatistics::Clock::now() - _start); }
+
+private:
+    FrameStatistics& _statistics;
+    FrameStage _stage;
+    FrameStatistics::Clock::time_point _start;
+};
+
+} // namespace Lightscape
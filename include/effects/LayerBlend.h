@@ -0,0 +1,48 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| LayerBlend.h                                              |
+|                                                           |
+| Blend modes and kernels for effect layer compositing      |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QString>
+#include <cstddef>
+#include <cstdint>
+#include "RGBController.h"
+
+namespace Lightscape {
+
+enum class BlendMode {
+    Normal,     // Layer replaces what is below
+    Add,        // Saturating add, for highlights and alerts
+    Multiply,   // Darkens, white leaves the base untouched
+    Screen,     // Lightens, black leaves the base untouched
+    Max,        // Per-channel maximum
+    Alpha       // Layer brightness is its own alpha mask, black is transparent
+};
+
+// How one effect layer is merged into the layers below it
+struct LayerSettings {
+    BlendMode mode = BlendMode::Normal;
+    int opacity = 100; // 0-100
+
+    bool operator==(const LayerSettings& other) const {
+        return mode == other.mode && opacity == other.opacity;
+    }
+};
+
+QString blendModeToString(BlendMode mode);
+BlendMode blendModeFromString(const QString& name);
+
+/**
+ * Blends 'count' layer colors into 'dst'. Only LEDs with a non-zero 'mask'
+ * byte (i.e. written by the layer this frame) are touched. 'opacity' is
+ * 0-255. Uses SSE2 for the common full-opacity cases where available.
+ */
+void blendLayer(BlendMode mode, uint8_t opacity, const RGBColor* src, const uint8_t* mask,
+                RGBColor* dst, size_t count);
+
+} // namespace Lightscape
@@ -0,0 +1,55 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| PositionBatch.h                                           |
+|                                                           |
+| Structure-of-arrays grid positions for batch evaluation   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <vector>
+#include "grid/GridTypes.h"
+
+namespace Lightscape {
+
+/**
+ * Grid positions stored as separate x/y/z arrays so that effects can run
+ * tight (auto-vectorizable) loops over a whole frame in one call.
+ * clear() keeps the capacity, so a batch reused every frame stops
+ * allocating once it has grown to the frame size.
+ */
+struct PositionBatch
+{
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<int> z;
+
+    void clear()
+    {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    void reserve(size_t count)
+    {
+        x.reserve(count);
+        y.reserve(count);
+        z.reserve(count);
+    }
+
+    void append(const GridPosition& pos)
+    {
+        x.push_back(pos.x);
+        y.push_back(pos.y);
+        z.push_back(pos.z);
+    }
+
+    size_t size() const { return x.size(); }
+    bool isEmpty() const { return x.empty(); }
+
+    GridPosition at(size_t index) const { return GridPosition(x[index], y[index], z[index]); }
+};
+
+} // namespace Lightscape
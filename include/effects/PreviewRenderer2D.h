@@ -13,6 +13,7 @@
 #include "grid/GridTypes.h"
 #include "grid/SpatialGrid.h"
 #include "effects/BaseEffect.h"
+#include "effects/PositionBatch.h"
 
 namespace Lightscape {
 
@@ -33,6 +34,10 @@ private:
     void drawCells(QPainter& painter, const GridDimensions& dims, float cellSize, 
                   float offsetX, float offsetY, SpatialGrid* grid, BaseEffect* effect, 
                   int activeLayer, bool deviceOnlyMode, const QSet<GridPosition>& devicePositions);
+    
+    // Batch evaluation buffers, reused between repaints
+    PositionBatch _cellPositions;
+    std::vector<RGBColor> _cellColors;
 };
 
 } // namespace Lightscape
\ No newline at end of file
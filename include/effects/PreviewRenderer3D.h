@@ -14,9 +14,12 @@
 #include <QVector3D>
 #include <QPointF>
 #include <QMatrix4x4>
+#include "core/FrameArena.h"
+#include "core/Span.h"
 #include "grid/GridTypes.h"
 #include "grid/SpatialGrid.h"
 #include "effects/BaseEffect.h"
+#include "effects/PositionBatch.h"
 
 namespace Lightscape {
 
@@ -37,18 +40,24 @@ private:
         QColor color;                   // Cell color
         QVector3D center;               // 3D position
         float depth;                    // For depth sorting
-        QString label;                  // Position label
-        QVector<QPointF> projectedCorners; // Projected corners
+        QPointF projectedCorners[8];    // Projected corners, front face first
     };
 
     void drawControls(QPainter& painter, int width, int height);
     void drawGridOutlines(QPainter& painter, const GridDimensions& dims, float cellSize, 
                          float layerSpacing, QMatrix4x4& transform, 
                          float centerX, float centerY, SpatialGrid* grid);
-    void drawCells(QPainter& painter, std::vector<CellInfo>& cells, 
-                  const GridDimensions& dims, float cellSize);
+    void drawCells(QPainter& painter, ConstSpan<CellInfo> cells, 
+                  const GridDimensions& dims, float cellSize, SpatialGrid* grid);
     
     QPointF project(const QVector3D& point, QMatrix4x4& transform, float centerX, float centerY);
+    
+    // Batch evaluation buffers, reused between repaints
+    PositionBatch _cellPositions;
+    std::vector<RGBColor> _cellColors;
+    
+    // Per-repaint cell list, reset at the start of every draw()
+    FrameArena _frameArena;
 };
 
 } // namespace Lightscape
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| RenderSnapshot.h                                          |
+|                                                           |
+| Immutable render configuration for the render thread      |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+#include "core/Types.h"
+#include "devices/DeviceHandle.h"
+#include "effects/LayerBlend.h"
+
+namespace Lightscape {
+
+class BaseEffect;
+class ControllerZone;
+class PreviewRenderer;
+
+/**
+ * Everything the render thread needs to draw a frame. The UI thread builds a
+ * new snapshot whenever the configuration changes and publishes it with an
+ * atomic pointer swap; a published snapshot is never modified, so the render
+ * thread reads it without locks or copies. Device lists are flattened into
+ * contiguous arrays here, once per change, so effects get them as spans.
+ */
+struct RenderSnapshot
+{
+    struct Layer
+    {
+        BaseEffect* effect = nullptr;
+        LayerSettings settings;
+        std::vector<DeviceInfo> devices;
+    };
+
+    struct Preview
+    {
+        BaseEffect* effect = nullptr;
+        ControllerZone* zone = nullptr;
+    };
+
+    quint64 version = 0;
+
+    std::vector<Layer> layers;                  // running effects, bottom layer first
+    BaseEffect* activeEffect = nullptr;         // legacy zone rendering, null unless running
+    std::vector<ControllerZone*> activeZones;
+    std::vector<Preview> previews;
+    PreviewRenderer* previewRenderer = nullptr;
+
+    // Controllers the device indices refer to, taken when the device lists
+    // were set. 'deviceBinding' changes whenever they were taken again.
+    quint64 deviceBinding = 0;
+    std::shared_ptr<const std::vector<DeviceHandle>> deviceHandles;
+};
+
+} // namespace Lightscape
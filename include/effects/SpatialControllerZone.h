@@ -7,9 +7,12 @@
 
 // Forward declaration for DeviceManager
 class DeviceManager;
+class SpatialField;
 
 namespace Lightscape {
 
+class FrameCompositor;
+
 /**
  * Abstract base class for controller zones, used by effects
  * This provides a common interface for both spatial and non-spatial zones
@@ -60,10 +63,21 @@ public:
     GridPosition position;
     ::DeviceManager* deviceManager;
     
+    // When set, LED writes go into the frame buffer instead of straight to the device
+    FrameCompositor* compositor = nullptr;
+    
+    // The effect's field for the current frame (render thread); queries against
+    // its reference point become table lookups
+    const SpatialField* field = nullptr;
+    
     // Spatial operations
     float getDistanceFrom(const GridPosition& reference) const;
     float getAngleFrom(const GridPosition& reference, int axis) const;
     
+    // Table lookups against a precomputed field (reference point is the field's)
+    float getDistanceFrom(const SpatialField& field) const;
+    float getAngleFrom(const SpatialField& field, int axis) const;
+    
     // ControllerZone interface implementation
     unsigned int getLEDCount() const override;
     void setLED(int led_idx, RGBColor color, int brightness = 100, int temperature = 0, int tint = 0) override;
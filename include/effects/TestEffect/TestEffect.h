@@ -19,8 +19,12 @@ public:
     // Implement the required virtual method for spatial color calculation
     RGBColor getColorForPosition(const GridPosition& pos, float time) override;
     
+    // Batch version used by the engine and the preview
+    void getColorsForPositions(const PositionBatch& positions, float time,
+                               const EffectParameters& params, RGBColor* colors) override;
+    
     // Optional: Override StepEffect if custom behavior is needed
-    void StepEffect(std::vector<ControllerZone*> zones) override;
+    void StepEffect(ConstSpan<ControllerZone*> zones) override;
 }; 
 
 // Register effect outside the class definition
@@ -19,6 +19,8 @@ class EffectsControlPanel;
 
 namespace Lightscape {
 
+class FrameStatsView;
+
 class EffectsControlPanel : public QWidget
 {
     Q_OBJECT
@@ -38,6 +40,7 @@ private:
     QTabWidget* _tabWidget;
     QMap<BaseEffect*, int> _effectTabs; // Maps effects to their tab index
     BaseEffect* _currentEffect;
+    FrameStatsView* _statsView;
     
     void setupUI();
     QString getEffectTabName(BaseEffect* effect) const;
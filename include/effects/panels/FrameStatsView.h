@@ -0,0 +1,45 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameStatsView.h                                          |
+|                                                           |
+| Small view of render thread frame timings                 |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QGroupBox>
+
+class QLabel;
+class QTableWidget;
+class QTimer;
+
+namespace Lightscape {
+
+/**
+ * Collapsible box showing the EffectManager frame statistics: p50/p95/p99/max
+ * per stage and per controller flush, frame-miss counters and the rate each
+ * controller's output worker achieves. Only polls while it is expanded.
+ */
+class FrameStatsView : public QGroupBox
+{
+    Q_OBJECT
+
+public:
+    explicit FrameStatsView(QWidget* parent = nullptr);
+
+private slots:
+    void refresh();
+    void onToggled(bool expanded);
+
+private:
+    QWidget* _content;
+    QLabel* _summaryLabel;
+    QTableWidget* _table;
+    QLabel* _outputLabel;
+    QTimer* _refreshTimer;
+
+    void setRow(int row, const QString& name, int p50, int p95, int p99, int max);
+};
+
+} // namespace Lightscape
@@ -0,0 +1,99 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| SpatialField.h                                            |
+|                                                           |
+| Precomputed distance/angle fields for a reference point   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "grid/GridTypes.h"
+#include "core/Span.h"
+
+/**
+ * Immutable per-cell distance and angle tables for one reference point.
+ * Cells are stored densely in x-fastest order, so a lookup is one index
+ * calculation. Normalized distance is relative to the farthest assigned
+ * position (or the farthest grid cell when nothing is assigned), which
+ * gives radial effects a full 0..1 gradient across the real devices.
+ */
+class SpatialField
+{
+public:
+    enum Plane {
+        PlaneXY = 0,
+        PlaneXZ = 1,
+        PlaneYZ = 2
+    };
+
+    SpatialField(const GridPosition& reference, int width, int height, int depth,
+                 const QList<GridPosition>& assignedPositions);
+
+    GridPosition GetReference() const { return reference; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    int GetDepth() const { return depth; }
+    size_t GetCellCount() const { return distances.size(); }
+    float GetMaxDistance() const { return max_distance; }
+
+    // Returns -1 for positions outside the grid
+    int IndexOf(const GridPosition& pos) const;
+
+    // Read-only tables, indexed by IndexOf()
+    Lightscape::ConstSpan<float> Distances() const { return distances; }
+    Lightscape::ConstSpan<float> NormalizedDistances() const { return normalized_distances; }
+    Lightscape::ConstSpan<float> Angles(Plane plane) const { return angles[plane]; }
+
+    // Single lookups, falling back to direct math outside the grid
+    float GetDistance(const GridPosition& pos) const;
+    float GetNormalizedDistance(const GridPosition& pos) const;
+    float GetAngle(const GridPosition& pos, Plane plane) const;
+
+    static float ComputeDistance(const GridPosition& pos, const GridPosition& reference);
+    static float ComputeAngle(const GridPosition& pos, const GridPosition& reference, Plane plane);
+
+private:
+    GridPosition reference;
+    int width;
+    int height;
+    int depth;
+    float max_distance;
+
+    std::vector<float> distances;
+    std::vector<float> normalized_distances;
+    std::vector<float> angles[3];
+};
+
+/**
+ * Lazily built SpatialFields keyed by reference point. Owned by the
+ * SpatialGrid and invalidated when the dimensions change or a cell gains
+ * its first or loses its last assignment. Get() may be called from the render thread;
+ * a returned field stays valid (and unchanged) for as long as the caller
+ * holds the pointer, even if the cache is invalidated meanwhile.
+ */
+class SpatialFieldCache
+{
+public:
+    std::shared_ptr<const SpatialField> Get(const GridPosition& reference);
+
+    // Drops every field and records the layout the next fields are built from
+    void Invalidate(int width, int height, int depth, const QList<GridPosition>& assignedPositions);
+
+    // Number of fields built since construction (diagnostics)
+    int GetBuildCount() const;
+
+private:
+    mutable std::mutex mutex;
+    QHash<GridPosition, std::shared_ptr<const SpatialField>> fields;
+    int width = 0;
+    int height = 0;
+    int depth = 0;
+    QList<GridPosition> assigned_positions;
+    int build_count = 0;
+};
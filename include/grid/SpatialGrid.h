@@ -3,12 +3,19 @@
 #include <QObject>
 #include <QGridLayout>
 #include <QPushButton>
+#include <QHash>
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QVector>
 #include <optional>
+#include <memory>
+#include <cstdint>
+#include <vector>
 #include "RGBController.h"
 #include "grid/GridTypes.h"
+#include "grid/SpatialField.h"
+#include "core/Span.h"
 #include "core/Types.h"
 
 // Forward declarations
@@ -57,6 +64,22 @@ public:
     }
 };
 
+// Hashes the same fields operator== compares, so the color is not part of the key.
+// qHash(int) is the identity, so the fields are chained through a multiplicative
+// mix; a plain XOR would map (zone 0, LED 3) and (zone 3, LED 0) together.
+inline uint qHash(const DeviceAssignment& assignment, uint seed = 0) noexcept
+{
+    uint hash = seed;
+    for (uint field : { static_cast<uint>(assignment.device_index),
+                        static_cast<uint>(assignment.device_type),
+                        static_cast<uint>(assignment.zone_index),
+                        static_cast<uint>(assignment.led_index) }) {
+        hash = (hash ^ field) * 0x9E3779B1u;
+        hash ^= hash >> 15;
+    }
+    return hash;
+}
+
 class SpatialGrid : public QObject {
     Q_OBJECT
 
@@ -94,6 +117,35 @@ public:
     void ClearAssignments(const GridPosition& pos);
     void ClearAllAssignments();
     bool UpdateAssignmentColor(const GridPosition& pos, int index, const RGBColor& color);
+    bool UpdateAssignment(const GridPosition& pos, int index, const DeviceAssignment& assignment);
+    
+    // Batched edits: mutations between Begin and Commit emit no per-cell
+    // assignmentsChanged; the outermost Commit emits assignmentsCommitted once
+    // with every touched position. Batches nest.
+    void BeginAssignmentBatch();
+    void CommitAssignmentBatch();
+    bool IsAssignmentBatchActive() const { return batch_depth > 0; }
+    
+    // Scoped Begin/Commit pair
+    class AssignmentBatch {
+    public:
+        explicit AssignmentBatch(SpatialGrid* grid) : grid(grid) { if (grid) grid->BeginAssignmentBatch(); }
+        ~AssignmentBatch() { if (grid) grid->CommitAssignmentBatch(); }
+        AssignmentBatch(const AssignmentBatch&) = delete;
+        AssignmentBatch& operator=(const AssignmentBatch&) = delete;
+    private:
+        SpatialGrid* grid;
+    };
+    
+    // Non-copying access; the views are valid until the next assignment change
+    Lightscape::ConstSpan<DeviceAssignment> GetAssignmentSpan(const GridPosition& pos) const;
+    QList<GridPosition> GetAssignedPositions() const;
+    int GetAssignedCellCount() const { return assigned_cells; }
+    
+    // Calls fn(const GridPosition&, ConstSpan<DeviceAssignment>) for every assigned
+    // cell in x, y, z order - a linear sweep over the cell array
+    template<typename Fn>
+    void ForEachAssignedCell(Fn fn) const;
 
     // User Position Management
     bool SetUserPosition(const GridPosition& pos);
@@ -108,12 +160,17 @@ public:
     
     // Get position for a device
     std::optional<GridPosition> GetDevicePosition(const Lightscape::DeviceInfo& device) const;
+    QList<GridPosition> GetDevicePositions(const Lightscape::DeviceInfo& device) const;
+    
+    // Precomputed distance/angle tables for a reference point (safe to call from the render thread)
+    std::shared_ptr<const SpatialField> GetSpatialField(const GridPosition& reference) const;
 
 signals:
     void positionSelected(const GridPosition& pos);
     void selectionChanged(QPushButton* button);
     void gridUpdated();
     void assignmentsChanged(const GridPosition& pos);
+    void assignmentsCommitted(const QSet<GridPosition>& positions);
     void userPositionChanged(const GridPosition& pos);
     void userPositionRequired(const QString& warning);
     void layerLabelChanged(int layer, const QString& newLabel);
@@ -124,11 +181,33 @@ private:
     GridPosition selected_position;
     QMap<GridPosition, QString> position_labels;
     QMap<int, QString> layer_labels;
-    QMap<GridPosition, QList<DeviceAssignment>> assignments;
+    
+    // Dense assignment storage: one span per cell (index = x + y*w + z*w*h) into a
+    // shared pool. Edits append or leave holes; CompactAssignments() restores cell order.
+    struct CellSpan {
+        uint32_t offset = 0;
+        uint32_t count = 0;
+    };
+    std::vector<CellSpan> cell_spans;
+    std::vector<DeviceAssignment> assignment_pool;
+    size_t pool_garbage = 0;
+    int assigned_cells = 0;
+    
+    // Reverse index: device/zone/LED -> every cell holding it, once per assignment
+    QHash<DeviceAssignment, QList<GridPosition>> device_positions;
+    
+    // Cells left outside the grid by SetDimensions, restored when it grows back
+    QMap<GridPosition, std::vector<DeviceAssignment>> parked_cells;
+    
+    int batch_depth = 0;
+    QSet<GridPosition> batch_positions;
+    
     QMap<QPushButton*, GridPosition> button_positions;
     std::optional<GridPosition> user_position;
     bool requires_user_position;
     QString user_position_warning;
+    mutable SpatialFieldCache field_cache;
+    bool spatial_layout_dirty = false;     // a cell became assigned or empty since the last invalidation
     
     // Button styles
     static const QString USER_POSITION_STYLE;
@@ -141,4 +220,26 @@ private:
     bool ValidatePosition(const GridPosition& pos) const;
     QPushButton* GetButtonAtPosition(const GridPosition& pos) const;
     void UpdateButtonStyle(QPushButton* button, const GridPosition& pos);
-};
\ No newline at end of file
+    void InvalidateSpatialFields();
+    
+    int CellIndex(const GridPosition& pos) const;
+    GridPosition CellPosition(int index) const;
+    void CompactAssignments();
+    QList<GridPosition> ResizeAssignmentStorage(const GridDimensions& newDimensions);
+    void IndexAssignment(const DeviceAssignment& assignment, const GridPosition& pos);
+    void UnindexAssignment(const DeviceAssignment& assignment, const GridPosition& pos);
+    void RebuildDeviceIndex();
+    void NotifyAssignmentsChanged(const GridPosition& pos);
+};
+
+template<typename Fn>
+void SpatialGrid::ForEachAssignedCell(Fn fn) const
+{
+    for (size_t i = 0; i < cell_spans.size(); i++) {
+        const CellSpan& span = cell_spans[i];
+        if (span.count > 0) {
+            fn(CellPosition(static_cast<int>(i)),
+               Lightscape::ConstSpan<DeviceAssignment>(assignment_pool.data() + span.offset, span.count));
+        }
+    }
+}
\ No newline at end of file
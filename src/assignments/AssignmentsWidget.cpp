@@ -89,19 +89,20 @@ void AssignmentsWidget::onColorButtonClicked()
                 if (assignment.device_type == Lightscape::DeviceType::RGB) {
                     bool success = false;
                     
-                    // Handle RGB device color updates through device manager
+                    // Handle RGB device color updates through device manager, one update on commit
+                    DeviceManager::ColorWriteBatch batch(deviceManager);
                     if (assignment.zone_index >= 0) {
-                        success = deviceManager->SetZoneColor(assignment.device_index, assignment.zone_index, rgbColor);
+                        success = batch.SetZone(assignment.device_index, assignment.zone_index, rgbColor);
                     }
                     else if (assignment.led_index >= 0) {
-                        success = deviceManager->SetLEDColor(assignment.device_index, assignment.led_index, rgbColor);
+                        success = batch.SetLED(assignment.device_index, assignment.led_index, rgbColor);
                     }
                     else {
-                        success = deviceManager->SetDeviceColor(assignment.device_index, rgbColor);
+                        success = batch.SetDevice(assignment.device_index, rgbColor);
                     }
                     
                     if (success) {
-                        deviceManager->UpdateDevice(assignment.device_index);
+                        batch.Commit();
                         spatialGrid->UpdateAssignmentColor(pos, index, rgbColor);
                         emit colorChangeRequested(rgbColor);
                     }
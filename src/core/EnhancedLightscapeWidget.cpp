@@ -17,9 +17,19 @@
 #include <QDebug>
 
 EnhancedLightscapeWidget::EnhancedLightscapeWidget(ResourceManager* resourceManager, QWidget* parent)
+    : EnhancedLightscapeWidget(resourceManager, new DeviceManager(resourceManager), parent)
+{
+}
+
+EnhancedLightscapeWidget::EnhancedLightscapeWidget(ControllerSource* controllerSource, QWidget* parent)
+    : EnhancedLightscapeWidget(nullptr, new DeviceManager(controllerSource, nullptr), parent)
+{
+}
+
+EnhancedLightscapeWidget::EnhancedLightscapeWidget(ResourceManager* resourceManager, DeviceManager* deviceManager, QWidget* parent)
     : QWidget(parent)
     , _resourceManager(resourceManager)
-    , _deviceManager(new DeviceManager(resourceManager))
+    , _deviceManager(deviceManager)
     , _spatialGrid(new SpatialGrid())
     , _nonRGBDeviceManager(new NonRGBDeviceManager(this))
     , _nonRGBGridManager(new NonRGBGridManager(_spatialGrid, this))
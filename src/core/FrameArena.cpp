@@ -0,0 +1,52 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameArena.cpp                                            |
+|                                                           |
+| Bump allocator for per-frame temporaries                  |
+\*---------------------------------------------------------*/
+
+#include "core/FrameArena.h"
+#include <algorithm>
+
+namespace Lightscape {
+
+FrameArena::FrameArena(size_t capacity)
+    : _block(capacity > 0 ? new unsigned char[capacity] : nullptr)
+    , _capacity(capacity)
+{
+}
+
+void FrameArena::reset()
+{
+    _highWater = std::max(_highWater, getUsed());
+
+    // Outgrew the block last frame: replace it and the overflow with one block
+    if (!_overflow.empty()) {
+        _overflow.clear();
+        _overflowBytes = 0;
+
+        // Headroom for the alignment padding of a frame laid out differently
+        _capacity = _highWater + _highWater / 4;
+        _block.reset(new unsigned char[_capacity]);
+    }
+
+    _offset = 0;
+}
+
+void* FrameArena::allocateBytes(size_t size, size_t alignment)
+{
+    // new[] aligns the block for any fundamental type, so aligning the offset is enough
+    size_t start = (_offset + alignment - 1) & ~(alignment - 1);
+    if (_block && start + size <= _capacity) {
+        _offset = start + size;
+        return _block.get() + start;
+    }
+
+    // Doesn't fit: this frame keeps a separate block, reset() folds it in
+    _overflow.emplace_back(new unsigned char[size]);
+    _overflowBytes += size + alignment;
+    return _overflow.back().get();
+}
+
+} // namespace Lightscape
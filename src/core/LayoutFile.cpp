@@ -0,0 +1,157 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| LayoutFile.cpp                                            |
+|                                                           |
+| Versioned binary container for layouts and profiles      |
+\*---------------------------------------------------------*/
+
+#include "core/LayoutFile.h"
+#include <QCborMap>
+#include <QCborParserError>
+
+const QString LayoutFile::GridSection = QStringLiteral("grid");
+const QString LayoutFile::AssignmentsSection = QStringLiteral("assignments");
+const QString LayoutFile::NonRGBDevicesSection = QStringLiteral("non_rgb_devices");
+const QString LayoutFile::EffectsSection = QStringLiteral("effects");
+const QString LayoutFile::NamesSection = QStringLiteral("names");
+
+namespace {
+
+const QString FormatName = QStringLiteral("lightscape");
+
+// Encoding of the self-describe tag 55799
+const char SignatureBytes[] = { '\xd9', '\xd9', '\xf7' };
+
+} // namespace
+
+void LayoutFile::setSection(const QString& name, const QCborValue& value)
+{
+    encoded.remove(name);
+    values.insert(name, value);
+}
+
+bool LayoutFile::hasSection(const QString& name) const
+{
+    return values.contains(name) || encoded.contains(name);
+}
+
+QStringList LayoutFile::sectionNames() const
+{
+    QStringList names = values.keys();
+    for (const QString& name : encoded.keys()) {
+        if (!names.contains(name)) names.append(name);
+    }
+    return names;
+}
+
+QCborValue LayoutFile::section(const QString& name) const
+{
+    auto value = values.constFind(name);
+    if (value != values.constEnd()) {
+        return *value;
+    }
+
+    auto bytes = encoded.constFind(name);
+    if (bytes != encoded.constEnd()) {
+        return QCborValue::fromCbor(*bytes);
+    }
+
+    return QCborValue();
+}
+
+QByteArray LayoutFile::toCbor() const
+{
+    QCborMap sections;
+    for (auto it = encoded.constBegin(); it != encoded.constEnd(); ++it) {
+        sections.insert(it.key(), QCborValue(it.value()));
+    }
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        sections.insert(it.key(), QCborValue(it.value().toCbor()));
+    }
+
+    QCborMap root;
+    root.insert(QStringLiteral("format"), FormatName);
+    root.insert(QStringLiteral("version"), FormatVersion);
+    root.insert(QStringLiteral("sections"), sections);
+
+    return QCborValue(QCborKnownTags::Signature, root).toCbor();
+}
+
+std::optional<LayoutFile> LayoutFile::fromCbor(const QByteArray& data, QString* error)
+{
+    auto fail = [error](const QString& message) -> std::optional<LayoutFile> {
+        if (error) *error = message;
+        return std::nullopt;
+    };
+
+    QCborParserError parseError;
+    QCborValue value = QCborValue::fromCbor(data, &parseError);
+    if (parseError.error != QCborError::NoError) {
+        return fail(parseError.errorString());
+    }
+
+    // Section payloads stay byte strings here; that is what keeps loading lazy
+    QCborMap root = value.taggedValue().toMap();
+    if (root.value(QStringLiteral("format")).toString() != FormatName) {
+        return fail(QStringLiteral("not a Lightscape layout file"));
+    }
+
+    int version = static_cast<int>(root.value(QStringLiteral("version")).toInteger());
+    if (version < 1 || version > FormatVersion) {
+        return fail(QStringLiteral("unsupported layout version %1").arg(version));
+    }
+
+    LayoutFile file;
+    file.fileVersion = version;
+
+    QCborMap sections = root.value(QStringLiteral("sections")).toMap();
+    for (auto it = sections.constBegin(); it != sections.constEnd(); ++it) {
+        if (it.value().isByteArray()) {
+            file.encoded.insert(it.key().toString(), it.value().toByteArray());
+        }
+    }
+
+    return file;
+}
+
+bool LayoutFile::isLayoutData(const QByteArray& data)
+{
+    return data.startsWith(QByteArray::fromRawData(SignatureBytes, sizeof(SignatureBytes)));
+}
+
+int LayoutNameTable::intern(const QString& name)
+{
+    if (name.isEmpty()) return -1;
+
+    auto it = refs.constFind(name);
+    if (it != refs.constEnd()) {
+        return it.value();
+    }
+
+    int ref = names.size();
+    names.append(name);
+    refs.insert(name, ref);
+    return ref;
+}
+
+QString LayoutNameTable::name(int ref) const
+{
+    return (ref >= 0 && ref < names.size()) ? names.at(ref) : QString();
+}
+
+QCborArray LayoutNameTable::toCbor() const
+{
+    return QCborArray::fromStringList(names);
+}
+
+LayoutNameTable LayoutNameTable::fromCbor(const QCborArray& array)
+{
+    LayoutNameTable table;
+    table.names.reserve(array.size());
+    for (const QCborValue& value : array) {
+        table.refs.insert(value.toString(), table.names.size());
+        table.names.append(value.toString());
+    }
+    return table;
+}
@@ -8,9 +8,11 @@
 
 #include "core/LightscapePlugin.h"
 #include "devices/DeviceManager.h"
+#include "devices/MockControllerBackend.h"
 #include "core/EnhancedLightscapeWidget.h"
 #include "core/ThemeManager.h"
 #include "core/LoggingManager.h"
+#include "core/SettingsManager.h"
 #include <QApplication>
 #include <QMenu>
 #include <QMessageBox>
@@ -23,7 +25,8 @@ LightscapePlugin::LightscapePlugin() :
     tray_manager(nullptr),
     state_manager(new StateManager(this)),
     widget(nullptr),
-    device_manager(nullptr)
+    device_manager(nullptr),
+    mock_backend(nullptr)
 {
     // Set log level to Error (will only show errors)
     Lightscape::LoggingManager::getInstance().setLogLevel(Lightscape::LogLevel::Error);
@@ -128,19 +131,20 @@ bool LightscapePlugin::initializePlugin(bool dark, ResourceManager* manager)
            testEffectInfo.name.toStdString().c_str(),
            testEffectInfo.id.toStdString().c_str());
     
-    if (!resource_handler->initialize(manager))
+    if (!initializeResources(manager))
     {
-        handlePluginError(QString("Failed to initialize resource handler: ") + 
-                         resource_handler->getLastError());
         return false;
     }
 
     // Initialize device management
-    device_manager = new DeviceManager(resource_handler->getResourceManager(), this);
+    ControllerSource* controller_source = resource_handler->getControllerSource();
+    device_manager = controller_source ? new DeviceManager(controller_source, this)
+                                       : new DeviceManager(resource_handler->getResourceManager(), this);
 
     if (widget == nullptr)
     {
-        widget = new EnhancedLightscapeWidget(resource_handler->getResourceManager());
+        widget = controller_source ? new EnhancedLightscapeWidget(controller_source)
+                                   : new EnhancedLightscapeWidget(resource_handler->getResourceManager());
         widget->setStyleSheet(ThemeManager::getStyleSheet(dark));
         widget->initializeGrid();
     }
@@ -157,6 +161,41 @@ bool LightscapePlugin::initializePlugin(bool dark, ResourceManager* manager)
     return true;
 }
 
+bool LightscapePlugin::initializeResources(ResourceManager* manager)
+{
+    // LIGHTSCAPE_MOCK_DEVICES swaps OpenRGB's controllers for stand-ins with
+    // simulated bus latency, e.g. "6*linear:4x32,matrix:22x6@8~4"
+    QByteArray mock_specs = qgetenv("LIGHTSCAPE_MOCK_DEVICES");
+    bool initialized = false;
+
+    if (!mock_specs.isEmpty())
+    {
+        std::vector<MockControllerSpec> specs;
+        std::string error;
+        if (!MockControllerBackend::ParseSpecs(mock_specs.toStdString(), specs, &error))
+        {
+            handlePluginError(QString("Invalid LIGHTSCAPE_MOCK_DEVICES: ") + QString::fromStdString(error));
+            return false;
+        }
+
+        printf("[Lightscape][Plugin] Using %zu mock controllers\n", specs.size());
+        mock_backend = new MockControllerBackend(specs);
+        initialized = resource_handler->initialize(mock_backend);
+    }
+    else
+    {
+        initialized = resource_handler->initialize(manager);
+    }
+
+    if (!initialized)
+    {
+        handlePluginError(QString("Failed to initialize resource handler: ") + 
+                         resource_handler->getLastError());
+        return false;
+    }
+    return true;
+}
+
 QWidget* LightscapePlugin::GetWidget()
 {
     // Logging disabled, except for errors
@@ -187,6 +226,9 @@ void LightscapePlugin::Unload()
     
     state_manager->setState(StateManager::PluginState::Disabled);
 
+    // Pending settings must reach the disk while the grid still exists
+    SettingsManager::getInstance().flush();
+
     if (widget != nullptr)
     {
         delete widget;
@@ -206,6 +248,13 @@ void LightscapePlugin::Unload()
     }
 
     resource_handler->cleanup();
+
+    // Last, nothing above may still be writing to the mock controllers
+    if (mock_backend != nullptr)
+    {
+        delete mock_backend;
+        mock_backend = nullptr;
+    }
 }
 
 void LightscapePlugin::handleResourceError(const QString& error)
@@ -12,6 +12,7 @@
 #include <QMutexLocker>
 #include <QTextStream>
 #include <QFileInfo>
+#include <cstdarg>
 
 // Convenience for module usage
 using namespace Lightscape;
@@ -303,6 +304,24 @@ void LoggingManager::verbose(const QString& message) {
     logMessage(LogLevel::Verbose, message);
 }
 
+void LoggingManager::log(LogLevel level, const QString& message) {
+    logMessage(level, message);
+}
+
+constexpr int LogRateLimiter::MaxPerSecond;
+
+QString LogRateLimiter::format(int suppressed, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    QString message = QString::vasprintf(fmt, args);
+    va_end(args);
+    
+    if (suppressed > 0) {
+        message += QString(" (%1 similar messages suppressed)").arg(suppressed);
+    }
+    return message;
+}
+
 void LoggingManager::logMessage(LogLevel level, const QString& message) {
     // Special case: Always allow the plugin loaded message through
     bool isLoadedMessage = message.contains("Plugin loaded successfully");
@@ -11,6 +11,7 @@
 ResourceHandler::ResourceHandler(QObject* parent)
     : QObject(parent)
     , _resource_manager(nullptr)
+    , _controller_source(nullptr)
     , _initialized(false)
 {
     printf("[Lightscape][ResourceHandler] Creating resource handler.\n");
@@ -43,6 +44,28 @@ bool ResourceHandler::initialize(ResourceManager* manager)
     return true;
 }
 
+bool ResourceHandler::initialize(ControllerSource* source)
+{
+    printf("[Lightscape][ResourceHandler] Initializing with controller source.\n");
+
+    if (_initialized)
+    {
+        setError("Resource handler already initialized");
+        return false;
+    }
+
+    if (!source)
+    {
+        setError("Invalid controller source pointer");
+        return false;
+    }
+
+    _controller_source = source;
+    _initialized = true;
+    emit resourcesInitialized();
+    return true;
+}
+
 void ResourceHandler::cleanup()
 {
     if (_initialized)
@@ -50,6 +73,7 @@ void ResourceHandler::cleanup()
         printf("[Lightscape][ResourceHandler] Cleaning up resources.\n");
         
         _resource_manager = nullptr;
+        _controller_source = nullptr;
         _initialized = false;
         emit resourcesCleanedUp();
     }
@@ -65,6 +89,11 @@ ResourceManager* ResourceHandler::getResourceManager() const
     return _resource_manager;
 }
 
+ControllerSource* ResourceHandler::getControllerSource() const
+{
+    return _controller_source;
+}
+
 bool ResourceHandler::hasError() const
 {
     return !_last_error.isEmpty();
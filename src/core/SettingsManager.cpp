@@ -2,10 +2,106 @@
 #include "core/LoggingManager.h"
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QCborArray>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QSaveFile>
 #include <QDir>
 #include <QStandardPaths>
+#include <QTimer>
 #include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// Field order of a compact record in the assignments section
+enum AssignmentField
+{
+    FieldDevice,
+    FieldType,
+    FieldZone,
+    FieldLED,
+    FieldColor,
+    FieldDeviceName,
+    FieldZoneName,
+    FieldLEDName
+};
+
+/*
+ * Maps a compact record back to the current device, zone and LED indices
+ * through the DeviceManager name index.
+ */
+class NameResolver
+{
+public:
+    NameResolver(DeviceManager* deviceManager, const LayoutNameTable& names)
+        : deviceManager(deviceManager), names(names) {}
+
+    std::optional<DeviceAssignment> resolve(const QCborArray& record) const;
+
+private:
+    DeviceManager* deviceManager;
+    const LayoutNameTable& names;
+};
+
+std::optional<DeviceAssignment> NameResolver::resolve(const QCborArray& record) const
+{
+    int deviceIndex = static_cast<int>(record.at(FieldDevice).toInteger());
+    Lightscape::DeviceType deviceType = static_cast<Lightscape::DeviceType>(record.at(FieldType).toInteger());
+
+    // Resolve by name; only records saved without one fall back to the index,
+    // since a missing device's index may now belong to a different one
+    QString deviceName = names.name(static_cast<int>(record.at(FieldDeviceName).toInteger(-1)));
+    if (!deviceName.isEmpty())
+    {
+        deviceIndex = deviceManager->FindDevice(deviceName, deviceType);
+        if (deviceIndex < 0) return std::nullopt;
+    }
+    else if (!deviceManager->ValidateDeviceIndex(deviceIndex, deviceType))
+    {
+        return std::nullopt;
+    }
+
+    DeviceAssignment assignment(deviceIndex, deviceType);
+    assignment.zone_index = static_cast<int>(record.at(FieldZone).toInteger(-1));
+    assignment.led_index = static_cast<int>(record.at(FieldLED).toInteger(-1));
+    assignment.color = static_cast<RGBColor>(record.at(FieldColor).toInteger());
+
+    // A zone or LED saved by name that isn't there (yet) is unresolved like a
+    // missing device; its saved index may now be a different zone or LED
+    QString zoneName = names.name(static_cast<int>(record.at(FieldZoneName).toInteger(-1)));
+    if (deviceType == Lightscape::DeviceType::RGB && assignment.zone_index >= 0 && !zoneName.isEmpty())
+    {
+        assignment.zone_index = deviceManager->FindZone(deviceIndex, zoneName);
+        if (assignment.zone_index < 0) return std::nullopt;
+    }
+
+    QString ledName = names.name(static_cast<int>(record.at(FieldLEDName).toInteger(-1)));
+    if (deviceType == Lightscape::DeviceType::RGB && assignment.led_index >= 0 && !ledName.isEmpty())
+    {
+        assignment.led_index = deviceManager->FindLED(deviceIndex, ledName);
+        if (assignment.led_index < 0) return std::nullopt;
+    }
+
+    return assignment;
+}
+
+QCborArray makeRecord(const DeviceAssignment& assignment, int deviceName, int zoneName, int ledName)
+{
+    // In AssignmentField order
+    QCborArray record;
+    record.append(static_cast<qint64>(assignment.device_index));
+    record.append(static_cast<int>(assignment.device_type));
+    record.append(assignment.zone_index);
+    record.append(assignment.led_index);
+    record.append(static_cast<qint64>(assignment.color));
+    record.append(deviceName);
+    record.append(zoneName);
+    record.append(ledName);
+    return record;
+}
+
+} // namespace
 
 SettingsManager::SettingsManager(QObject* parent)
     : QObject(parent)
@@ -13,6 +109,44 @@ SettingsManager::SettingsManager(QObject* parent)
     , nonRGBDeviceManager(nullptr)
     , deviceManager(nullptr)
 {
+    saveTimer = new QTimer(this);
+    saveTimer->setSingleShot(true);
+    saveTimer->setInterval(DefaultSaveDelayMs);
+    connect(saveTimer, &QTimer::timeout, this, &SettingsManager::writeState);
+}
+
+void SettingsManager::setSaveDelay(int milliseconds)
+{
+    saveTimer->setInterval(qMax(0, milliseconds));
+}
+
+void SettingsManager::flush()
+{
+    // Write a change that is still waiting for its timer, then wait for the disk
+    if (saveTimer->isActive())
+    {
+        saveTimer->stop();
+        writeState();
+    }
+
+    writer.flush();
+
+    PersistenceStats stats = getPersistenceStats();
+    LOG_INFO(QString("SettingsManager: %1 save requests, %2 files written, %3 writes avoided")
+             .arg(stats.saveRequests).arg(stats.filesWritten).arg(stats.writesAvoided));
+}
+
+SettingsManager::PersistenceStats SettingsManager::getPersistenceStats() const
+{
+    SettingsWriter::Stats writerStats = writer.stats();
+
+    PersistenceStats stats;
+    stats.saveRequests = saveRequests;
+    stats.snapshots = writerStats.queued;
+    stats.filesWritten = writerStats.written;
+    stats.writeFailures = writerStats.failed;
+    stats.writesAvoided = coalescedRequests + writerStats.superseded;
+    return stats;
 }
 
 void SettingsManager::initialize(SpatialGrid* grid, NonRGBDeviceManager* nonRGBManager, DeviceManager* deviceManager)
@@ -25,8 +159,15 @@ void SettingsManager::initialize(SpatialGrid* grid, NonRGBDeviceManager* nonRGBM
     if (spatialGrid)
     {
         connect(spatialGrid, &SpatialGrid::assignmentsChanged, this, &SettingsManager::saveState);
+        connect(spatialGrid, &SpatialGrid::assignmentsCommitted, this, &SettingsManager::saveState);
         connect(spatialGrid, &SpatialGrid::userPositionChanged, this, &SettingsManager::saveState);
         connect(spatialGrid, &SpatialGrid::layerLabelChanged, this, &SettingsManager::saveState);
+
+        // A deferred write must not read a grid that is gone
+        connect(spatialGrid, &QObject::destroyed, this, [this]() {
+            saveTimer->stop();
+            spatialGrid = nullptr;
+        });
     }
 
     if (nonRGBDeviceManager)
@@ -38,6 +179,8 @@ void SettingsManager::initialize(SpatialGrid* grid, NonRGBDeviceManager* nonRGBM
     if (deviceManager)
     {
         connect(deviceManager, &DeviceManager::deviceAssignmentChanged, this, &SettingsManager::saveState);
+        connect(deviceManager, &DeviceManager::deviceListChanged, this, &SettingsManager::remapAssignments);
+        assignmentNames = deviceManager->GetNameIndex();
     }
 
     // Load existing state if any
@@ -62,7 +205,32 @@ QString SettingsManager::getSettingsPath() const
     return configPath + "/" + settingsFileName;
 }
 
+QString SettingsManager::getLegacySettingsPath() const
+{
+    QString path = getSettingsPath();
+    return path.left(path.lastIndexOf('/') + 1) + legacySettingsFileName;
+}
+
 void SettingsManager::saveState()
+{
+    // loadState saves once at the end, not for every restored item
+    if (restoringState)
+    {
+        return;
+    }
+
+    // Changes inside one window share a single write
+    saveRequests++;
+    if (saveTimer->isActive())
+    {
+        coalescedRequests++;
+        return;
+    }
+
+    saveTimer->start();
+}
+
+void SettingsManager::writeState()
 {
     if (!spatialGrid || !nonRGBDeviceManager || !deviceManager)
     {
@@ -70,7 +238,14 @@ void SettingsManager::saveState()
         return;
     }
 
-    QJsonObject state;
+    // Snapshot on the GUI thread; encoding and writing happen on the writer thread
+    writer.submit(getSettingsPath(), captureLayout());
+}
+
+LayoutFile SettingsManager::captureLayout()
+{
+    LayoutFile layout;
+    QJsonObject grid;
 
     // Save grid dimensions
     QJsonObject gridObject;
@@ -78,7 +253,7 @@ void SettingsManager::saveState()
     gridObject["width"] = dims.width;
     gridObject["height"] = dims.height;
     gridObject["depth"] = dims.depth;
-    state["grid_dimensions"] = gridObject;
+    grid["grid_dimensions"] = gridObject;
 
     // Save user position if set
     if (spatialGrid->HasUserPosition())
@@ -90,7 +265,7 @@ void SettingsManager::saveState()
             userPos["x"] = pos->x;
             userPos["y"] = pos->y;
             userPos["z"] = pos->z;
-            state["user_position"] = userPos;
+            grid["user_position"] = userPos;
         }
     }
 
@@ -104,7 +279,9 @@ void SettingsManager::saveState()
             layerLabels[QString::number(i)] = label;
         }
     }
-    state["layer_labels"] = layerLabels;
+    grid["layer_labels"] = layerLabels;
+
+    layout.setSection(LayoutFile::GridSection, QCborValue::fromJsonValue(grid));
 
     // Save non-RGB devices
     QJsonArray nonRGBDevices;
@@ -145,104 +322,147 @@ void SettingsManager::saveState()
 
         nonRGBDevices.append(deviceObj);
     }
-    state["non_rgb_devices"] = nonRGBDevices;
 
-    // Save grid assignments
-    QJsonArray assignments;
-    for (int z = 0; z < dims.depth; z++)
-    {
-        for (int y = 0; y < dims.height; y++)
+    layout.setSection(LayoutFile::NonRGBDevicesSection, QCborValue::fromJsonValue(nonRGBDevices));
+
+    // Save grid assignments as compact records, cell by cell; names go to the shared table
+    LayoutNameTable names;
+    QCborArray cells;
+    spatialGrid->ForEachAssignedCell([&](const GridPosition& pos, Lightscape::ConstSpan<DeviceAssignment> span) {
+        QCborArray records;
+        for (const DeviceAssignment& assignment : span)
         {
-            for (int x = 0; x < dims.width; x++)
-            {
-                GridPosition pos(x, y, z);
-                if (spatialGrid->HasAssignments(pos))
-                {
-                    QJsonObject posAssignments;
-                    posAssignments["x"] = x;
-                    posAssignments["y"] = y;
-                    posAssignments["z"] = z;
+            records.append(encodeAssignment(assignment, names));
+        }
+        cells.append(QCborArray{ pos.x, pos.y, pos.z, records });
+    });
 
-                    QJsonArray deviceAssignments;
-                    for (const DeviceAssignment& assignment : spatialGrid->GetAssignments(pos))
-                    {
-                        QJsonObject assignObj;
-                        assignObj["device_index"] = static_cast<int>(assignment.device_index);
-                        assignObj["device_type"] = static_cast<int>(assignment.device_type);
-                        assignObj["zone_index"] = assignment.zone_index;
-                        assignObj["led_index"] = assignment.led_index;
-                        assignObj["color"] = static_cast<int>(assignment.color);
-                        
-                        // Save device name for more reliable identification across sessions
-                        if (assignment.device_type == Lightscape::DeviceType::RGB && 
-                            deviceManager && deviceManager->ValidateDeviceIndex(assignment.device_index, Lightscape::DeviceType::RGB)) {
-                            assignObj["device_name"] = deviceManager->GetRGBDeviceName(assignment.device_index);
-                            
-                            // Save zone/LED name if applicable
-                            if (assignment.zone_index >= 0) {
-                                assignObj["zone_name"] = deviceManager->GetZoneName(assignment.device_index, assignment.zone_index);
-                            }
-                            if (assignment.led_index >= 0) {
-                                assignObj["led_name"] = deviceManager->GetLEDName(assignment.device_index, assignment.led_index);
-                            }
-                        }
-                        else if (assignment.device_type == Lightscape::DeviceType::NonRGB && 
-                                 deviceManager && deviceManager->ValidateDeviceIndex(assignment.device_index, Lightscape::DeviceType::NonRGB)) {
-                            assignObj["device_name"] = deviceManager->GetNonRGBDeviceName(assignment.device_index);
-                        }
-                        
-                        deviceAssignments.append(assignObj);
-                    }
-                    posAssignments["assignments"] = deviceAssignments;
-                    assignments.append(posAssignments);
-                }
-            }
+    // Parked assignments only have their names; the loader resolves them the same way
+    for (const ParkedAssignment& parked : parkedAssignments)
+    {
+        QCborArray record = makeRecord(parked.assignment, names.intern(parked.deviceName),
+                                       names.intern(parked.zoneName), names.intern(parked.ledName));
+        cells.append(QCborArray{ parked.pos.x, parked.pos.y, parked.pos.z, QCborArray{ record } });
+    }
+    layout.setSection(LayoutFile::AssignmentsSection, cells);
+    layout.setSection(LayoutFile::NamesSection, names.toCbor());
+
+    return layout;
+}
+
+QCborArray SettingsManager::encodeAssignment(const DeviceAssignment& assignment, LayoutNameTable& names) const
+{
+    int deviceName = -1;
+    int zoneName = -1;
+    int ledName = -1;
+
+    // Names make the assignment survive device index changes across sessions
+    if (assignment.device_type == Lightscape::DeviceType::RGB &&
+        deviceManager->ValidateDeviceIndex(assignment.device_index, Lightscape::DeviceType::RGB))
+    {
+        const DeviceNameIndex& nameIndex = deviceManager->GetNameIndex();
+        deviceName = names.intern(nameIndex.DeviceName(assignment.device_index));
+        if (assignment.zone_index >= 0)
+        {
+            zoneName = names.intern(nameIndex.ZoneName(assignment.device_index, assignment.zone_index));
         }
+        if (assignment.led_index >= 0)
+        {
+            ledName = names.intern(nameIndex.LEDName(assignment.device_index, assignment.led_index));
+        }
+    }
+    else if (assignment.device_type == Lightscape::DeviceType::NonRGB &&
+             deviceManager->ValidateDeviceIndex(assignment.device_index, Lightscape::DeviceType::NonRGB))
+    {
+        deviceName = names.intern(deviceManager->GetNonRGBDeviceName(assignment.device_index));
     }
-    state["assignments"] = assignments;
 
-    // Save to file
-    QJsonDocument doc(state);
-    QFile file(getSettingsPath());
-    
-    if (!file.open(QIODevice::WriteOnly))
+    return makeRecord(assignment, deviceName, zoneName, ledName);
+}
+
+void SettingsManager::loadState()
+{
+    // Never read behind a write that is still in flight
+    writer.flush();
+
+    std::optional<LayoutFile> layout = readLayout();
+    if (!layout)
     {
-        LOG_WARNING("SettingsManager: Could not open settings file for writing: " + file.errorString());
         return;
     }
 
-    file.write(doc.toJson(QJsonDocument::Indented));
-    LOG_DEBUG("SettingsManager: State saved successfully");
+    QElapsedTimer timer;
+    timer.start();
+
+    applyLayout(*layout);
+
+    LOG_INFO(QString("SettingsManager: State loaded successfully in %1 ms").arg(timer.elapsed()));
 }
 
-void SettingsManager::loadState()
+std::optional<LayoutFile> SettingsManager::readLayout() const
 {
     QFile file(getSettingsPath());
     if (!file.exists())
     {
+        // State saved before the binary format is imported once, then saved as CBOR
+        QString legacyPath = getLegacySettingsPath();
+        if (QFile::exists(legacyPath))
+        {
+            LOG_INFO("SettingsManager: Importing JSON settings from " + legacyPath);
+            return readJsonLayout(legacyPath);
+        }
+
         LOG_DEBUG("SettingsManager: No saved state found");
-        return;
+        return std::nullopt;
     }
 
     if (!file.open(QIODevice::ReadOnly))
     {
         LOG_WARNING("SettingsManager: Could not open settings file for reading: " + file.errorString());
-        return;
+        return std::nullopt;
+    }
+
+    QString error;
+    std::optional<LayoutFile> layout = LayoutFile::fromCbor(file.readAll(), &error);
+    if (!layout)
+    {
+        LOG_WARNING("SettingsManager: Failed to parse settings file: " + error);
+    }
+
+    return layout;
+}
+
+std::optional<LayoutFile> SettingsManager::readJsonLayout(const QString& path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        LOG_WARNING("SettingsManager: Could not open settings file for reading: " + file.errorString());
+        return std::nullopt;
     }
 
     QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
     if (doc.isNull())
     {
         LOG_WARNING("SettingsManager: Failed to parse settings file");
-        return;
+        return std::nullopt;
     }
 
-    QJsonObject state = doc.object();
+    return layoutFromJson(doc.object());
+}
+
+void SettingsManager::applyLayout(const LayoutFile& layout)
+{
+    // Collect every grid change of the restore into one assignmentsCommitted
+    restoringState = true;
+    spatialGrid->BeginAssignmentBatch();
+
+    QJsonObject grid = layout.section(LayoutFile::GridSection).toJsonValue().toObject();
 
     // Restore grid dimensions
-    if (state.contains("grid_dimensions"))
+    if (grid.contains("grid_dimensions"))
     {
-        QJsonObject gridObject = state["grid_dimensions"].toObject();
+        QJsonObject gridObject = grid["grid_dimensions"].toObject();
         GridDimensions dims(
             gridObject["width"].toInt(),
             gridObject["height"].toInt(),
@@ -252,9 +472,9 @@ void SettingsManager::loadState()
     }
 
     // Restore user position
-    if (state.contains("user_position"))
+    if (grid.contains("user_position"))
     {
-        QJsonObject userPos = state["user_position"].toObject();
+        QJsonObject userPos = grid["user_position"].toObject();
         GridPosition pos(
             userPos["x"].toInt(),
             userPos["y"].toInt(),
@@ -264,9 +484,9 @@ void SettingsManager::loadState()
     }
 
     // Restore layer labels
-    if (state.contains("layer_labels"))
+    if (grid.contains("layer_labels"))
     {
-        QJsonObject layerLabels = state["layer_labels"].toObject();
+        QJsonObject layerLabels = grid["layer_labels"].toObject();
         for (const QString& key : layerLabels.keys())
         {
             spatialGrid->SetLayerLabel(key.toInt(), layerLabels[key].toString());
@@ -274,12 +494,17 @@ void SettingsManager::loadState()
     }
 
     // Restore non-RGB devices
-    if (state.contains("non_rgb_devices"))
+    if (layout.hasSection(LayoutFile::NonRGBDevicesSection))
     {
-        QJsonArray devices = state["non_rgb_devices"].toArray();
+        QJsonArray devices = layout.section(LayoutFile::NonRGBDevicesSection).toJsonValue().toArray();
         for (const QJsonValue& value : devices)
         {
             QJsonObject deviceObj = value.toObject();
+            if (nonRGBDeviceManager->hasDevice(deviceObj["name"].toString()))
+            {
+                continue;
+            }
+
             NonRGBDevice* device = new NonRGBDevice(
                 deviceObj["name"].toString(),
                 static_cast<NonRGBDeviceType>(deviceObj["type"].toInt())
@@ -318,87 +543,62 @@ void SettingsManager::loadState()
     }
 
     // Restore grid assignments
-    if (state.contains("assignments"))
+    if (layout.hasSection(LayoutFile::AssignmentsSection))
     {
-        QJsonArray assignments = state["assignments"].toArray();
-        for (const QJsonValue& value : assignments)
+        spatialGrid->ClearAllAssignments();
+        parkedAssignments.clear();
+
+        LayoutNameTable names = LayoutNameTable::fromCbor(layout.section(LayoutFile::NamesSection).toArray());
+        NameResolver resolver(deviceManager, names);
+
+        QCborArray cells = layout.section(LayoutFile::AssignmentsSection).toArray();
+        for (const QCborValue& cellValue : cells)
         {
-            QJsonObject posAssignments = value.toObject();
+            QCborArray cell = cellValue.toArray();
             GridPosition pos(
-                posAssignments["x"].toInt(),
-                posAssignments["y"].toInt(),
-                posAssignments["z"].toInt()
+                static_cast<int>(cell.at(0).toInteger()),
+                static_cast<int>(cell.at(1).toInteger()),
+                static_cast<int>(cell.at(2).toInteger())
             );
+            QString layerLabel = spatialGrid->GetLayerLabel(pos.z);
 
-            QJsonArray deviceAssignments = posAssignments["assignments"].toArray();
-            for (const QJsonValue& assignValue : deviceAssignments)
+            for (const QCborValue& recordValue : cell.at(3).toArray())
             {
-                QJsonObject assignObj = assignValue.toObject();
-                // Try to find device by name first, if available
-                int deviceIndex = assignObj["device_index"].toInt();
-                Lightscape::DeviceType deviceType = static_cast<Lightscape::DeviceType>(assignObj["device_type"].toInt());
-                bool deviceFound = false;
-                
-                // If we have device name, try to find it by name
-                if (assignObj.contains("device_name") && deviceManager) {
-                    QString deviceName = assignObj["device_name"].toString();
-                    
-                    // Try to find the device by name
-                    unsigned int count = deviceManager->GetDeviceCount(deviceType);
-                    for (unsigned int i = 0; i < count; i++) {
-                        if (deviceManager->GetDeviceName(i, deviceType) == deviceName) {
-                            deviceIndex = i;
-                            deviceFound = true;
-                            break;
-                        }
-                    }
-                }
-                
-                // If we didn't find the device by name and the original index is invalid, skip this assignment
-                if (!deviceFound && !deviceManager->ValidateDeviceIndex(deviceIndex, deviceType)) {
-                    LOG_DEBUG("SettingsManager: Skipping assignment for device that no longer exists");
-                    continue;
-                }
-                
-                DeviceAssignment assignment(deviceIndex, deviceType);
-                assignment.zone_index = assignObj["zone_index"].toInt();
-                assignment.led_index = assignObj["led_index"].toInt();
-                assignment.color = static_cast<RGBColor>(assignObj["color"].toInt());
-                
-                // Try to match zone/LED by name if provided
-                if (deviceType == Lightscape::DeviceType::RGB && 
-                    assignment.zone_index >= 0 && assignObj.contains("zone_name")) {
-                    QString zoneName = assignObj["zone_name"].toString();
-                    size_t zoneCount = deviceManager->GetZoneCount(deviceIndex);
-                    
-                    for (size_t i = 0; i < zoneCount; i++) {
-                        if (deviceManager->GetZoneName(deviceIndex, static_cast<int>(i)) == zoneName) {
-                            assignment.zone_index = static_cast<int>(i);
-                            break;
-                        }
+                QCborArray record = recordValue.toArray();
+                std::optional<DeviceAssignment> assignment = resolver.resolve(record);
+                if (!assignment)
+                {
+                    // A named RGB device may just be unplugged or reconfigured: park it
+                    // until the device, zone and LED all show up again
+                    ParkedAssignment parked;
+                    parked.pos = pos;
+                    parked.assignment = DeviceAssignment(static_cast<unsigned int>(record.at(FieldDevice).toInteger()),
+                                                         static_cast<Lightscape::DeviceType>(record.at(FieldType).toInteger()));
+                    parked.assignment.zone_index = static_cast<int>(record.at(FieldZone).toInteger(-1));
+                    parked.assignment.led_index = static_cast<int>(record.at(FieldLED).toInteger(-1));
+                    parked.assignment.color = static_cast<RGBColor>(record.at(FieldColor).toInteger());
+                    parked.deviceName = names.name(static_cast<int>(record.at(FieldDeviceName).toInteger(-1)));
+                    parked.zoneName = names.name(static_cast<int>(record.at(FieldZoneName).toInteger(-1)));
+                    parked.ledName = names.name(static_cast<int>(record.at(FieldLEDName).toInteger(-1)));
+
+                    if (parked.assignment.device_type == Lightscape::DeviceType::RGB && !parked.deviceName.isEmpty())
+                    {
+                        LOG_DEBUG("SettingsManager: Parking unresolved assignment for device " + parked.deviceName);
+                        parkedAssignments.append(parked);
                     }
-                }
-                
-                if (deviceType == Lightscape::DeviceType::RGB && 
-                    assignment.led_index >= 0 && assignObj.contains("led_name")) {
-                    QString ledName = assignObj["led_name"].toString();
-                    size_t ledCount = deviceManager->GetLEDCount(deviceIndex);
-                    
-                    for (size_t i = 0; i < ledCount; i++) {
-                        if (deviceManager->GetLEDName(deviceIndex, static_cast<int>(i)) == ledName) {
-                            assignment.led_index = static_cast<int>(i);
-                            break;
-                        }
+                    else
+                    {
+                        LOG_DEBUG("SettingsManager: Skipping assignment for device that no longer exists");
                     }
+                    continue;
                 }
 
-                spatialGrid->AddAssignment(pos, assignment);
-                
+                spatialGrid->AddAssignment(pos, *assignment);
+
                 // Update device manager
-                QString layerLabel = spatialGrid->GetLayerLabel(pos.z);
                 deviceManager->SetDeviceAssignment(
-                    assignment.device_index,
-                    assignment.device_type,
+                    assignment->device_index,
+                    assignment->device_type,
                     layerLabel,
                     pos
                 );
@@ -406,5 +606,325 @@ void SettingsManager::loadState()
         }
     }
 
-    LOG_INFO("SettingsManager: State loaded successfully");
-}
\ No newline at end of file
+    // The commit emits once and triggers the single save
+    restoringState = false;
+    spatialGrid->CommitAssignmentBatch();
+
+    assignmentNames = deviceManager->GetNameIndex();
+}
+
+void SettingsManager::remapAssignments()
+{
+    if (!spatialGrid || !deviceManager)
+    {
+        return;
+    }
+
+    const DeviceNameIndex& current = deviceManager->GetNameIndex();
+    if (current.Generation() == assignmentNames.Generation())
+    {
+        return;
+    }
+
+    // Take the new generation first: the updates below signal deviceListChanged again
+    DeviceNameIndex previous = assignmentNames;
+    assignmentNames = current;
+
+    struct Remap
+    {
+        GridPosition pos;
+        int index;
+        DeviceAssignment from;
+        DeviceAssignment to;
+    };
+    QList<Remap> changes;
+    QList<Remap> removals;
+    QList<ParkedAssignment> newlyParked;
+
+    // Old index -> name in the previous generation -> index in the current one
+    spatialGrid->ForEachAssignedCell([&](const GridPosition& pos, Lightscape::ConstSpan<DeviceAssignment> span) {
+        for (size_t i = 0; i < span.size(); i++)
+        {
+            const DeviceAssignment& old = span[i];
+            if (old.device_type != Lightscape::DeviceType::RGB) continue;
+
+            QString deviceName = previous.DeviceName(old.device_index);
+            int device = deviceName.isEmpty() ? -1 : current.FindDevice(deviceName);
+
+            if (device < 0 && deviceName.isEmpty()) continue;
+
+            QString zoneName = old.zone_index >= 0 ? previous.ZoneName(old.device_index, old.zone_index) : QString();
+            QString ledName = old.led_index >= 0 ? previous.LEDName(old.device_index, old.led_index) : QString();
+
+            DeviceAssignment updated = old;
+            updated.device_index = device;
+            if (device >= 0 && !zoneName.isEmpty()) updated.zone_index = current.FindZone(device, zoneName);
+            if (device >= 0 && !ledName.isEmpty()) updated.led_index = current.FindLED(device, ledName);
+
+            // A device, zone or LED that is gone takes the assignment off the grid, by
+            // name, so its old index can't end up pointing at whatever takes that slot
+            bool lost = device < 0 ||
+                        (old.zone_index >= 0 && updated.zone_index < 0) ||
+                        (old.led_index >= 0 && updated.led_index < 0);
+            if (lost)
+            {
+                ParkedAssignment parked;
+                parked.pos = pos;
+                parked.assignment = old;
+                parked.deviceName = deviceName;
+                parked.zoneName = zoneName;
+                parked.ledName = ledName;
+                newlyParked.append(parked);
+                removals.append({ pos, static_cast<int>(i), old, old });
+                continue;
+            }
+
+            if (!(updated == old))
+            {
+                changes.append({ pos, static_cast<int>(i), old, updated });
+            }
+        }
+    });
+
+    bool hasReturning = std::any_of(parkedAssignments.cbegin(), parkedAssignments.cend(), [&](const ParkedAssignment& parked) {
+        return resolveParkedAssignment(parked).has_value();
+    });
+    if (changes.isEmpty() && removals.isEmpty() && !hasReturning)
+    {
+        return;
+    }
+
+    SpatialGrid::AssignmentBatch batch(spatialGrid);
+
+    for (const Remap& change : changes)
+    {
+        spatialGrid->UpdateAssignment(change.pos, change.index, change.to);
+    }
+
+    // Back to front, so the indices of the ones still to go stay valid
+    for (auto it = removals.crbegin(); it != removals.crend(); ++it)
+    {
+        spatialGrid->RemoveAssignment(it->pos, it->index);
+    }
+
+    // All removals before all additions, so two devices can trade indices
+    for (const Remap& change : changes + removals)
+    {
+        deviceManager->RemoveDeviceAssignment(change.from.device_index, change.from.device_type);
+    }
+    for (const Remap& change : changes)
+    {
+        deviceManager->SetDeviceAssignment(change.to.device_index, change.to.device_type,
+                                           spatialGrid->GetLayerLabel(change.pos.z), change.pos);
+    }
+
+    int restored = 0;
+    for (auto it = parkedAssignments.begin(); it != parkedAssignments.end();)
+    {
+        if (restoreParkedAssignment(*it))
+        {
+            it = parkedAssignments.erase(it);
+            restored++;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    parkedAssignments += newlyParked;
+
+    LOG_INFO(QString("SettingsManager: Remapped %1, parked %2 and restored %3 assignments after a device list change")
+             .arg(changes.size()).arg(removals.size()).arg(restored));
+}
+
+std::optional<DeviceAssignment> SettingsManager::resolveParkedAssignment(const ParkedAssignment& parked) const
+{
+    const DeviceNameIndex& current = deviceManager->GetNameIndex();
+    int device = current.FindDevice(parked.deviceName);
+    if (device < 0)
+    {
+        return std::nullopt;
+    }
+
+    // As on load, a zone or LED that can't be found by name keeps it parked
+    DeviceAssignment assignment = parked.assignment;
+    assignment.device_index = device;
+    if (assignment.zone_index >= 0 && !parked.zoneName.isEmpty())
+    {
+        assignment.zone_index = current.FindZone(device, parked.zoneName);
+        if (assignment.zone_index < 0) return std::nullopt;
+    }
+    if (assignment.led_index >= 0 && !parked.ledName.isEmpty())
+    {
+        assignment.led_index = current.FindLED(device, parked.ledName);
+        if (assignment.led_index < 0) return std::nullopt;
+    }
+    return assignment;
+}
+
+bool SettingsManager::restoreParkedAssignment(const ParkedAssignment& parked)
+{
+    std::optional<DeviceAssignment> resolved = resolveParkedAssignment(parked);
+    if (!resolved)
+    {
+        return false;
+    }
+
+    const DeviceAssignment& assignment = *resolved;
+    spatialGrid->AddAssignment(parked.pos, assignment);
+    deviceManager->SetDeviceAssignment(assignment.device_index, assignment.device_type,
+                                       spatialGrid->GetLayerLabel(parked.pos.z), parked.pos);
+    return true;
+}
+
+bool SettingsManager::exportJson(const QString& path)
+{
+    if (!spatialGrid || !nonRGBDeviceManager || !deviceManager)
+    {
+        LOG_WARNING("SettingsManager: Cannot export state - managers not initialized");
+        return false;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        LOG_WARNING("SettingsManager: Could not open export file for writing: " + file.errorString());
+        return false;
+    }
+
+    file.write(QJsonDocument(layoutToJson(captureLayout())).toJson(QJsonDocument::Indented));
+    return file.commit();
+}
+
+bool SettingsManager::importJson(const QString& path)
+{
+    if (!spatialGrid || !nonRGBDeviceManager || !deviceManager)
+    {
+        LOG_WARNING("SettingsManager: Cannot import state - managers not initialized");
+        return false;
+    }
+
+    std::optional<LayoutFile> layout = readJsonLayout(path);
+    if (!layout)
+    {
+        return false;
+    }
+
+    applyLayout(*layout);
+    return true;
+}
+
+LayoutFile SettingsManager::layoutFromJson(const QJsonObject& state)
+{
+    LayoutFile layout;
+
+    QJsonObject grid;
+    for (const char* key : { "grid_dimensions", "user_position", "layer_labels" })
+    {
+        if (state.contains(key)) grid[key] = state.value(key);
+    }
+    layout.setSection(LayoutFile::GridSection, QCborValue::fromJsonValue(grid));
+
+    if (state.contains("non_rgb_devices"))
+    {
+        layout.setSection(LayoutFile::NonRGBDevicesSection, QCborValue::fromJsonValue(state.value("non_rgb_devices")));
+    }
+
+    if (state.contains("assignments"))
+    {
+        LayoutNameTable names;
+        QCborArray cells;
+
+        for (const QJsonValue& value : state.value("assignments").toArray())
+        {
+            QJsonObject posAssignments = value.toObject();
+
+            QCborArray records;
+            for (const QJsonValue& assignValue : posAssignments["assignments"].toArray())
+            {
+                QJsonObject assignObj = assignValue.toObject();
+
+                // In AssignmentField order
+                QCborArray record;
+                record.append(assignObj["device_index"].toInt());
+                record.append(assignObj["device_type"].toInt());
+                record.append(assignObj["zone_index"].toInt(-1));
+                record.append(assignObj["led_index"].toInt(-1));
+                record.append(static_cast<qint64>(static_cast<RGBColor>(assignObj["color"].toInt())));
+                record.append(names.intern(assignObj["device_name"].toString()));
+                record.append(names.intern(assignObj["zone_name"].toString()));
+                record.append(names.intern(assignObj["led_name"].toString()));
+                records.append(record);
+            }
+
+            cells.append(QCborArray{
+                posAssignments["x"].toInt(),
+                posAssignments["y"].toInt(),
+                posAssignments["z"].toInt(),
+                records
+            });
+        }
+
+        layout.setSection(LayoutFile::AssignmentsSection, cells);
+        layout.setSection(LayoutFile::NamesSection, names.toCbor());
+    }
+
+    return layout;
+}
+
+QJsonObject SettingsManager::layoutToJson(const LayoutFile& layout)
+{
+    QJsonObject state = layout.section(LayoutFile::GridSection).toJsonValue().toObject();
+
+    if (layout.hasSection(LayoutFile::NonRGBDevicesSection))
+    {
+        state["non_rgb_devices"] = layout.section(LayoutFile::NonRGBDevicesSection).toJsonValue();
+    }
+
+    if (layout.hasSection(LayoutFile::AssignmentsSection))
+    {
+        LayoutNameTable names = LayoutNameTable::fromCbor(layout.section(LayoutFile::NamesSection).toArray());
+        QJsonArray assignments;
+
+        for (const QCborValue& cellValue : layout.section(LayoutFile::AssignmentsSection).toArray())
+        {
+            QCborArray cell = cellValue.toArray();
+
+            QJsonObject posAssignments;
+            posAssignments["x"] = static_cast<int>(cell.at(0).toInteger());
+            posAssignments["y"] = static_cast<int>(cell.at(1).toInteger());
+            posAssignments["z"] = static_cast<int>(cell.at(2).toInteger());
+
+            QJsonArray deviceAssignments;
+            for (const QCborValue& recordValue : cell.at(3).toArray())
+            {
+                QCborArray record = recordValue.toArray();
+
+                QJsonObject assignObj;
+                assignObj["device_index"] = static_cast<int>(record.at(FieldDevice).toInteger());
+                assignObj["device_type"] = static_cast<int>(record.at(FieldType).toInteger());
+                assignObj["zone_index"] = static_cast<int>(record.at(FieldZone).toInteger());
+                assignObj["led_index"] = static_cast<int>(record.at(FieldLED).toInteger());
+                assignObj["color"] = static_cast<int>(record.at(FieldColor).toInteger());
+
+                const std::pair<const char*, int> nameFields[] = {
+                    { "device_name", FieldDeviceName }, { "zone_name", FieldZoneName }, { "led_name", FieldLEDName }
+                };
+                for (const auto& field : nameFields)
+                {
+                    QString name = names.name(static_cast<int>(record.at(field.second).toInteger(-1)));
+                    if (!name.isEmpty()) assignObj[field.first] = name;
+                }
+
+                deviceAssignments.append(assignObj);
+            }
+
+            posAssignments["assignments"] = deviceAssignments;
+            assignments.append(posAssignments);
+        }
+
+        state["assignments"] = assignments;
+    }
+
+    return state;
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| SettingsWriter.cpp                                        |
+|                                                           |
+| Background writer for the settings file                  |
+\*---------------------------------------------------------*/
+
+#include "core/SettingsWriter.h"
+#include "core/LoggingManager.h"
+#include <QSaveFile>
+
+SettingsWriter::~SettingsWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    // run() drains a pending snapshot before it exits
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void SettingsWriter::submit(const QString& path, const LayoutFile& layout)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!thread.joinable()) {
+            thread = std::thread(&SettingsWriter::run, this);
+        }
+
+        if (hasPending) {
+            counters.superseded++;
+        }
+
+        pendingPath = path;
+        pendingLayout = layout;
+        hasPending = true;
+        counters.queued++;
+    }
+    wake.notify_one();
+}
+
+void SettingsWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return !hasPending && !writing; });
+}
+
+SettingsWriter::Stats SettingsWriter::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void SettingsWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        wake.wait(lock, [this]() { return hasPending || stopping; });
+
+        if (!hasPending) break;
+
+        QString path = pendingPath;
+        LayoutFile layout = pendingLayout;
+        pendingLayout = LayoutFile();
+        hasPending = false;
+        writing = true;
+
+        lock.unlock();
+        bool ok = writeFile(path, layout);
+        lock.lock();
+
+        writing = false;
+        if (ok) {
+            counters.written++;
+        } else {
+            counters.failed++;
+        }
+
+        if (!hasPending) {
+            idle.notify_all();
+        }
+    }
+
+    idle.notify_all();
+}
+
+bool SettingsWriter::writeFile(const QString& path, const LayoutFile& layout)
+{
+    QSaveFile file(path);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOG_WARNING("SettingsManager: Could not open settings file for writing: " + file.errorString());
+        return false;
+    }
+
+    file.write(layout.toCbor());
+
+    // Renames the temp file over the old one only if every write succeeded
+    if (!file.commit()) {
+        LOG_WARNING("SettingsManager: Could not write settings file: " + file.errorString());
+        return false;
+    }
+
+    LOG_DEBUG("SettingsManager: State saved successfully");
+    return true;
+}
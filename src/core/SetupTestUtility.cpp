@@ -1,6 +1,7 @@
 #include "core/SetupTestUtility.h"
 #include <QMessageBox>
 #include <cmath>
+#include <vector>
 
 using namespace Lightscape;
 
@@ -103,11 +104,13 @@ QList<GridPosition> SetupTestUtility::testAllPositions()
     testInProgress = true;
     emit testStarted();
     
-    // Apply test color to all positions
+    // Apply test color to all positions, then update each device once
+    DeviceManager::ColorWriteBatch batch(deviceManager);
     for (const GridPosition& pos : positions) {
-        applyColorToPosition(pos, testColor);
+        applyColorToAssignments(pos, testColor, batch);
         emit positionTested(pos);
     }
+    batch.Commit();
     
     testInProgress = false;
     emit testCompleted();
@@ -139,21 +142,7 @@ void SetupTestUtility::testDistancePattern(bool continuous)
         patternTimer->start();
     } else {
         // Just do a one-time update
-        QList<GridPosition> positions = getAssignedPositions();
-        GridPosition refPoint = spatialGrid->GetUserPosition().value();
-        
-        // Calculate max distance for normalization
-        float maxDistance = 0.0f;
-        for (const GridPosition& pos : positions) {
-            float distance = calculateDistance(pos, refPoint);
-            maxDistance = std::max(maxDistance, distance);
-        }
-        
-        for (const GridPosition& pos : positions) {
-            float distance = calculateDistance(pos, refPoint);
-            RGBColor color = createDistanceColor(distance, maxDistance);
-            applyColorToPosition(pos, color);
-        }
+        applyPattern(1);
         
         testInProgress = false;
         emit testCompleted();
@@ -184,14 +173,7 @@ void SetupTestUtility::testWavePattern(bool continuous)
         patternTimer->start();
     } else {
         // Just do a one-time update
-        QList<GridPosition> positions = getAssignedPositions();
-        GridPosition refPoint = spatialGrid->GetUserPosition().value();
-        
-        for (const GridPosition& pos : positions) {
-            float distance = calculateDistance(pos, refPoint);
-            RGBColor color = createWaveColor(distance, currentTime);
-            applyColorToPosition(pos, color);
-        }
+        applyPattern(2);
         
         testInProgress = false;
         emit testCompleted();
@@ -210,44 +192,40 @@ void SetupTestUtility::updatePattern(float speedFactor)
         return;
     }
     
+    // Apply appropriate pattern, stop the timer if no positions are assigned
+    if (!applyPattern(activePattern)) {
+        stopPattern();
+    }
+}
+
+bool SetupTestUtility::applyPattern(int pattern)
+{
+    QList<GridPosition> positions = getAssignedPositions();
+    if (positions.isEmpty() || !spatialGrid->HasUserPosition()) {
+        return false;
+    }
+    
     GridPosition refPoint = spatialGrid->GetUserPosition().value();
     
-    // Get all positions with assignments
-    QList<GridPosition> positions = getAssignedPositions();
-    if (positions.isEmpty()) {
-        // Stop timer if no positions are assigned
-        stopPattern();
-        return;
+    // Distances come from the grid's cached field for the user position; its
+    // maximum is the farthest assigned cell, the same set as 'positions'
+    std::shared_ptr<const SpatialField> field = spatialGrid->GetSpatialField(refPoint);
+    std::vector<float> distances(positions.size());
+    float maxDistance = field->GetMaxDistance();
+    for (int i = 0; i < positions.size(); i++) {
+        distances[i] = field->GetDistance(positions[i]);
     }
     
-    // Apply appropriate pattern
-    switch (activePattern) {
-        case 1: { // Distance pattern
-            // Calculate max distance for normalization
-            float maxDistance = 0.0f;
-            for (const GridPosition& pos : positions) {
-                float distance = calculateDistance(pos, refPoint);
-                maxDistance = std::max(maxDistance, distance);
-            }
-            
-            // Apply colors based on distance
-            for (const GridPosition& pos : positions) {
-                float distance = calculateDistance(pos, refPoint);
-                RGBColor color = createDistanceColor(distance, maxDistance);
-                applyColorToPosition(pos, color);
-            }
-            break;
-        }
-        
-        case 2: { // Wave pattern
-            for (const GridPosition& pos : positions) {
-                float distance = calculateDistance(pos, refPoint);
-                RGBColor color = createWaveColor(distance, currentTime);
-                applyColorToPosition(pos, color);
-            }
-            break;
-        }
+    // One update per device for the whole frame
+    DeviceManager::ColorWriteBatch batch(deviceManager);
+    for (int i = 0; i < positions.size(); i++) {
+        RGBColor color = (pattern == 1) ? createDistanceColor(distances[i], maxDistance)
+                                        : createWaveColor(distances[i], currentTime);
+        applyColorToAssignments(positions[i], color, batch);
+        emit positionTested(positions[i]);
     }
+    
+    return true;
 }
 
 void SetupTestUtility::stopPattern()
@@ -278,10 +256,10 @@ void SetupTestUtility::resetAllDevices()
     
     // Reset all devices to their default state
     if (deviceManager) {
-        // Reset all RGB devices to black
+        // Reset all RGB devices to black, one update each
+        DeviceManager::ColorWriteBatch batch(deviceManager);
         for (unsigned int i = 0; i < deviceManager->GetRGBDeviceCount(); i++) {
-            deviceManager->SetDeviceColor(i, ToRGBColor(0, 0, 0));
-            deviceManager->UpdateDevice(i);
+            batch.SetDevice(i, ToRGBColor(0, 0, 0));
         }
     }
 }
@@ -296,27 +274,9 @@ void SetupTestUtility::resetPositionDevice(const GridPosition& pos)
         return;
     }
     
-    QList<DeviceAssignment> assignments = spatialGrid->GetAssignments(pos);
-    
-    for (const DeviceAssignment& assignment : assignments) {
-        // Reset the assignment's color to black (off)
-        spatialGrid->UpdateAssignmentColor(pos, assignments.indexOf(assignment), ToRGBColor(0, 0, 0));
-        
-        // Apply the color to the actual device
-        if (deviceManager) {
-            // Apply color based on assignment type
-            if (assignment.zone_index >= 0) {
-                deviceManager->SetZoneColor(assignment.device_index, assignment.zone_index, ToRGBColor(0, 0, 0));
-                deviceManager->UpdateDevice(assignment.device_index);
-            } else if (assignment.led_index >= 0) {
-                deviceManager->SetLEDColor(assignment.device_index, assignment.led_index, ToRGBColor(0, 0, 0));
-                deviceManager->UpdateDevice(assignment.device_index);
-            } else {
-                deviceManager->SetDeviceColor(assignment.device_index, ToRGBColor(0, 0, 0));
-                deviceManager->UpdateDevice(assignment.device_index);
-            }
-        }
-    }
+    // Reset the assignments' colors to black (off)
+    DeviceManager::ColorWriteBatch batch(deviceManager);
+    applyColorToAssignments(pos, ToRGBColor(0, 0, 0), batch);
 }
 
 QList<GridPosition> SetupTestUtility::getAssignedPositions() const
@@ -345,39 +305,37 @@ void SetupTestUtility::applyColorToPosition(const GridPosition& pos, const RGBCo
         return;
     }
     
-    QList<DeviceAssignment> assignments = spatialGrid->GetAssignments(pos);
-    
-    for (const DeviceAssignment& assignment : assignments) {
-        // Update the assignment's color (for visual feedback in the UI)
-        spatialGrid->UpdateAssignmentColor(pos, assignments.indexOf(assignment), color);
-        
-        // Apply the color to the actual device
-        if (deviceManager) {
-            // Apply color based on assignment type
-            if (assignment.zone_index >= 0) {
-                deviceManager->SetZoneColor(assignment.device_index, assignment.zone_index, color);
-                deviceManager->UpdateDevice(assignment.device_index);
-            } else if (assignment.led_index >= 0) {
-                deviceManager->SetLEDColor(assignment.device_index, assignment.led_index, color);
-                deviceManager->UpdateDevice(assignment.device_index);
-            } else {
-                deviceManager->SetDeviceColor(assignment.device_index, color);
-                deviceManager->UpdateDevice(assignment.device_index);
-            }
-        }
-    }
+    DeviceManager::ColorWriteBatch batch(deviceManager);
+    applyColorToAssignments(pos, color, batch);
+    batch.Commit();
     
     emit positionTested(pos);
 }
 
-float SetupTestUtility::calculateDistance(const GridPosition& pos1, const GridPosition& pos2) const
+void SetupTestUtility::applyColorToAssignments(const GridPosition& pos, const RGBColor& color,
+                                               DeviceManager::ColorWriteBatch& batch)
 {
-    // Calculate Euclidean distance between two grid positions
-    float dx = static_cast<float>(pos1.x - pos2.x);
-    float dy = static_cast<float>(pos1.y - pos2.y);
-    float dz = static_cast<float>(pos1.z - pos2.z);
+    QList<DeviceAssignment> assignments = spatialGrid->GetAssignments(pos);
     
-    return std::sqrt(dx*dx + dy*dy + dz*dz);
+    for (int i = 0; i < assignments.size(); i++) {
+        const DeviceAssignment& assignment = assignments[i];
+        
+        // Update the assignment's color (for visual feedback in the UI)
+        spatialGrid->UpdateAssignmentColor(pos, i, color);
+        
+        if (!deviceManager || assignment.device_type != Lightscape::DeviceType::RGB) {
+            continue;
+        }
+        
+        // Apply color based on assignment type
+        if (assignment.zone_index >= 0) {
+            batch.SetZone(assignment.device_index, assignment.zone_index, color);
+        } else if (assignment.led_index >= 0) {
+            batch.SetLED(assignment.device_index, assignment.led_index, color);
+        } else {
+            batch.SetDevice(assignment.device_index, color);
+        }
+    }
 }
 
 RGBColor SetupTestUtility::createDistanceColor(float distance, float maxDistance) const
@@ -1,11 +1,63 @@
 #include "devices/DeviceManager.h"
+#include <QTimer>
+#include <algorithm>
+
+namespace {
+
+// About one UI repaint; device updates arrive once per frame per controller
+const int DefaultNotificationInterval = 50;
+
+// Controller list of the running OpenRGB instance
+class ResourceManagerSource : public ControllerSource
+{
+public:
+    explicit ResourceManagerSource(ResourceManager* manager) : manager(manager) {}
+    std::vector<RGBController*>& GetRGBControllers() override { return manager->GetRGBControllers(); }
+
+private:
+    ResourceManager* manager;
+};
+
+// Runs on OpenRGB's detection thread; the refresh queues deviceListChanged
+void OnDeviceListChanged(void* arg)
+{
+    static_cast<DeviceManager*>(arg)->RefreshControllers();
+}
+
+} // namespace
 
 DeviceManager::DeviceManager(ResourceManager* resourceManager, QObject* parent)
     : QObject(parent)
     , resourceManager(resourceManager)
     , currentDeviceIndex(-1)
     , currentDeviceType(Lightscape::DeviceType::RGB)
+    , outputPool([this](const DeviceHandle& device, const std::vector<RGBColor>& colors) { return ApplyQueuedColors(device, colors); })
 {
+    if (resourceManager) {
+        ownedSource.reset(new ResourceManagerSource(resourceManager));
+        controllerSource = ownedSource.get();
+        resourceManager->RegisterDeviceListChangeCallback(OnDeviceListChanged, this);
+    }
+    InitializeNotifications();
+}
+
+DeviceManager::DeviceManager(ControllerSource* source, QObject* parent)
+    : QObject(parent)
+    , resourceManager(nullptr)
+    , controllerSource(source)
+    , currentDeviceIndex(-1)
+    , currentDeviceType(Lightscape::DeviceType::RGB)
+    , outputPool([this](const DeviceHandle& device, const std::vector<RGBColor>& colors) { return ApplyQueuedColors(device, colors); })
+{
+    InitializeNotifications();
+}
+
+DeviceManager::~DeviceManager()
+{
+    if (resourceManager) {
+        resourceManager->UnregisterDeviceListChangeCallback(OnDeviceListChanged, this);
+    }
+    outputPool.Stop();
 }
 
 QString DeviceManager::GetDeviceName(unsigned int index, Lightscape::DeviceType type) const
@@ -32,15 +84,17 @@ unsigned int DeviceManager::GetDeviceCount(Lightscape::DeviceType type) const
 
 unsigned int DeviceManager::GetRGBDeviceCount() const
 {
-    if (!resourceManager) return 0;
-    return static_cast<unsigned int>(resourceManager->GetRGBControllers().size());
+    if (!controllerSource) return 0;
+    std::unique_lock<std::mutex> listLock = controllerSource->LockControllers();
+    return static_cast<unsigned int>(controllerSource->GetRGBControllers().size());
 }
 
 QString DeviceManager::GetRGBDeviceName(unsigned int index) const
 {
     if (!ValidateDeviceIndex(index, Lightscape::DeviceType::RGB)) return QString();
     
-    auto& controllers = resourceManager->GetRGBControllers();
+    std::unique_lock<std::mutex> listLock = controllerSource->LockControllers();
+    auto& controllers = controllerSource->GetRGBControllers();
     if (index < controllers.size()) {
         return QString::fromStdString(controllers[index]->name);
     }
@@ -51,7 +105,8 @@ size_t DeviceManager::GetZoneCount(int deviceIndex) const
 {
     if (!ValidateDeviceIndex(deviceIndex, Lightscape::DeviceType::RGB)) return 0;
     
-    auto& controllers = resourceManager->GetRGBControllers();
+    std::unique_lock<std::mutex> listLock = controllerSource->LockControllers();
+    auto& controllers = controllerSource->GetRGBControllers();
     if (static_cast<size_t>(deviceIndex) < controllers.size()) {
         return controllers[deviceIndex]->zones.size();
     }
@@ -62,7 +117,8 @@ QString DeviceManager::GetZoneName(int deviceIndex, int zoneIndex) const
 {
     if (!ValidateZoneIndex(deviceIndex, zoneIndex)) return QString();
     
-    auto& controllers = resourceManager->GetRGBControllers();
+    std::unique_lock<std::mutex> listLock = controllerSource->LockControllers();
+    auto& controllers = controllerSource->GetRGBControllers();
     if (static_cast<size_t>(deviceIndex) < controllers.size()) {
         return QString::fromStdString(controllers[deviceIndex]->zones[zoneIndex].name);
     }
@@ -73,7 +129,8 @@ size_t DeviceManager::GetLEDCount(int deviceIndex) const
 {
     if (!ValidateDeviceIndex(deviceIndex, Lightscape::DeviceType::RGB)) return 0;
     
-    auto& controllers = resourceManager->GetRGBControllers();
+    std::unique_lock<std::mutex> listLock = controllerSource->LockControllers();
+    auto& controllers = controllerSource->GetRGBControllers();
     if (static_cast<size_t>(deviceIndex) < controllers.size()) {
         return controllers[deviceIndex]->leds.size();
     }
@@ -84,31 +141,160 @@ QString DeviceManager::GetLEDName(int deviceIndex, int ledIndex) const
 {
     if (!ValidateLEDIndex(deviceIndex, ledIndex)) return QString();
     
-    auto& controllers = resourceManager->GetRGBControllers();
+    std::unique_lock<std::mutex> listLock = controllerSource->LockControllers();
+    auto& controllers = controllerSource->GetRGBControllers();
     if (static_cast<size_t>(deviceIndex) < controllers.size()) {
         return QString::fromStdString(controllers[deviceIndex]->leds[ledIndex].name);
     }
     return QString();
 }
 
-bool DeviceManager::SetLEDColor(int deviceIndex, int ledIndex, RGBColor color)
+quint64 DeviceManager::RefreshControllers() const
+{
+    DeviceOutputPool::RetiredWorkers retired;
+    std::lock_guard<std::mutex> lock(controllerMutex);
+    return RefreshControllersLocked(retired);
+}
+
+quint64 DeviceManager::RefreshControllersLocked(DeviceOutputPool::RetiredWorkers& retired) const
 {
-    if (!ValidateLEDIndex(deviceIndex, ledIndex)) return false;
+    static std::vector<RGBController*> noControllers;
+    std::unique_lock<std::mutex> listLock = controllerSource ? controllerSource->LockControllers() : std::unique_lock<std::mutex>();
+    const std::vector<RGBController*>& controllers = controllerSource ? controllerSource->GetRGBControllers() : noControllers;
+
+    // A pointer and count comparison; the table is rebuilt only when the list changed
+    bool changed = (controllerGeneration == 0 || controllers.size() != controllerTable.size());
+    for (size_t i = 0; i < controllers.size() && !changed; i++) {
+        const DeviceHandle& handle = controllerTable[i];
+        changed = (controllers[i] != handle.controller ||
+                   controllers[i]->zones.size() != handle.zoneCount ||
+                   std::min(controllers[i]->leds.size(), controllers[i]->colors.size()) != handle.ledCount);
+    }
 
-    try {
-        auto& controllers = resourceManager->GetRGBControllers();
-        if (static_cast<size_t>(deviceIndex) < controllers.size()) {
-            auto controller = controllers[deviceIndex];
-            
-            // Update the colors array only
-            controller->colors[ledIndex] = color;
-            
-            // Let the controller handle LED updating
-            controller->UpdateSingleLED(ledIndex);
+    if (changed) {
+        bool rescan = (controllerGeneration != 0);
+        controllerGeneration++;
+        controllerTable.resize(controllers.size());
+        for (size_t i = 0; i < controllers.size(); i++) {
+            DeviceHandle& handle = controllerTable[i];
+            handle.controller = controllers[i];
+            handle.generation = controllerGeneration;
+            handle.index = static_cast<int>(i);
+            handle.zoneCount = static_cast<unsigned int>(controllers[i]->zones.size());
+            handle.ledCount = static_cast<unsigned int>(std::min(controllers[i]->leds.size(), controllers[i]->colors.size()));
+        }
+
+        // Controllers that left the list get no more frames. The caller joins their
+        // workers after releasing controllerMutex, before the source may free them.
+        outputPool.Retain(controllerTable, retired);
+
+        // Any thread can notice the change; listeners hear about it on the manager's
+        if (rescan) {
+            QMetaObject::invokeMethod(const_cast<DeviceManager*>(this), "deviceListChanged", Qt::QueuedConnection);
+        }
+    }
+
+    return controllerGeneration;
+}
+
+DeviceHandle DeviceManager::ResolveDevice(int deviceIndex) const
+{
+    DeviceOutputPool::RetiredWorkers retired;
+    {
+        std::lock_guard<std::mutex> lock(controllerMutex);
+        RefreshControllersLocked(retired);
+        if (deviceIndex >= 0 && static_cast<size_t>(deviceIndex) < controllerTable.size()) {
+            return controllerTable[deviceIndex];
+        }
+    }
+
+    SetError(deviceIndex < 0 ? "Invalid device index" : "Device index out of range");
+    return DeviceHandle();
+}
+
+std::vector<DeviceHandle> DeviceManager::GetDeviceHandles() const
+{
+    DeviceOutputPool::RetiredWorkers retired;
+    std::lock_guard<std::mutex> lock(controllerMutex);
+    RefreshControllersLocked(retired);
+    return controllerTable;
+}
+
+bool DeviceManager::RebindDevice(DeviceHandle& handle) const
+{
+    DeviceOutputPool::RetiredWorkers retired;
+    std::lock_guard<std::mutex> lock(controllerMutex);
+    quint64 generation = RefreshControllersLocked(retired);
+    if (handle.generation == generation) return handle.IsValid();
+
+    // Follow the controller, not the index. The old pointer is only compared,
+    // never dereferenced: the controller may have been deleted by the rescan.
+    for (const DeviceHandle& current : controllerTable) {
+        if (handle.controller && current.controller == handle.controller &&
+            current.zoneCount == handle.zoneCount && current.ledCount == handle.ledCount) {
+            handle = current;
             return true;
         }
+    }
+
+    handle = DeviceHandle();
+    handle.generation = generation;
+    return false;
+}
+
+const DeviceNameIndex& DeviceManager::GetNameIndex() const
+{
+    quint64 generation = RefreshControllers();
+
+    // Names are converted only when the controller list changed
+    if (nameIndex.Generation() != generation) {
+        static std::vector<RGBController*> noControllers;
+        std::unique_lock<std::mutex> listLock = controllerSource ? controllerSource->LockControllers() : std::unique_lock<std::mutex>();
+        nameIndex.Rebuild(controllerSource ? controllerSource->GetRGBControllers() : noControllers, generation);
+    }
+    return nameIndex;
+}
+
+int DeviceManager::FindDevice(const QString& name, Lightscape::DeviceType type) const
+{
+    if (type == Lightscape::DeviceType::RGB) {
+        return GetNameIndex().FindDevice(name);
+    }
+
+    // Non-RGB devices are few and owned here
+    for (int i = 0; i < nonRGBDevices.size(); i++) {
+        if (nonRGBDevices[i]->getName() == name) return i;
+    }
+    return -1;
+}
+
+int DeviceManager::FindZone(int deviceIndex, const QString& name) const
+{
+    return GetNameIndex().FindZone(deviceIndex, name);
+}
+
+int DeviceManager::FindLED(int deviceIndex, const QString& name) const
+{
+    return GetNameIndex().FindLED(deviceIndex, name);
+}
+
+bool DeviceManager::SetLEDColor(int deviceIndex, int ledIndex, RGBColor color)
+{
+    DeviceHandle device = ResolveDevice(deviceIndex);
+    return device.IsValid() && SetLEDColor(device, ledIndex, color);
+}
+
+bool DeviceManager::SetLEDColor(const DeviceHandle& device, int ledIndex, RGBColor color)
+{
+    if (!WriteLEDColors(device, Lightscape::ConstSpan<int>(&ledIndex, 1), Lightscape::ConstSpan<RGBColor>(&color, 1))) {
         return false;
     }
+
+    try {
+        // Let the controller handle LED updating
+        device.controller->UpdateSingleLED(ledIndex);
+        return true;
+    }
     catch (...) {
         SetError("Failed to set LED color");
         return false;
@@ -117,27 +303,21 @@ bool DeviceManager::SetLEDColor(int deviceIndex, int ledIndex, RGBColor color)
 
 bool DeviceManager::SetZoneColor(int deviceIndex, int zoneIndex, RGBColor color)
 {
-    if (!ValidateZoneIndex(deviceIndex, zoneIndex)) return false;
+    DeviceHandle device = ResolveDevice(deviceIndex);
+    return device.IsValid() && SetZoneColor(device, zoneIndex, color);
+}
 
-    try {
-        auto& controllers = resourceManager->GetRGBControllers();
-        if (static_cast<size_t>(deviceIndex) < controllers.size()) {
-            auto controller = controllers[deviceIndex];
-            
-            // Set the colors in the colors array
-            auto& zone = controller->zones[zoneIndex];
-            unsigned int start = zone.start_idx;
-            
-            for (unsigned int i = 0; i < zone.leds_count; i++) {
-                controller->colors[start + i] = color;
-            }
-            
-            // Update the zone
-            controller->UpdateZoneLEDs(zoneIndex);
-            return true;
-        }
+bool DeviceManager::SetZoneColor(const DeviceHandle& device, int zoneIndex, RGBColor color)
+{
+    if (!WriteZoneColors(device, zoneIndex, Lightscape::ConstSpan<RGBColor>(&color, 1))) {
         return false;
     }
+
+    try {
+        // Update the zone
+        device.controller->UpdateZoneLEDs(zoneIndex);
+        return true;
+    }
     catch (...) {
         SetError("Failed to set zone color");
         return false;
@@ -146,23 +326,15 @@ bool DeviceManager::SetZoneColor(int deviceIndex, int zoneIndex, RGBColor color)
 
 bool DeviceManager::SetDeviceColor(int deviceIndex, RGBColor color)
 {
-    if (!ValidateDeviceIndex(deviceIndex, Lightscape::DeviceType::RGB)) return false;
+    DeviceHandle device = ResolveDevice(deviceIndex);
+    if (!WriteDeviceColors(device, Lightscape::ConstSpan<RGBColor>(&color, 1))) {
+        return false;
+    }
 
     try {
-        auto& controllers = resourceManager->GetRGBControllers();
-        if (static_cast<size_t>(deviceIndex) < controllers.size()) {
-            auto controller = controllers[deviceIndex];
-            
-            // Set all colors in the colors array
-            for (unsigned int i = 0; i < controller->colors.size(); i++) {
-                controller->colors[i] = color;
-            }
-            
-            // Update all LEDs
-            controller->UpdateLEDs();
-            return true;
-        }
-        return false;
+        // Update all LEDs
+        device.controller->UpdateLEDs();
+        return true;
     }
     catch (...) {
         SetError("Failed to set device color");
@@ -172,24 +344,277 @@ bool DeviceManager::SetDeviceColor(int deviceIndex, RGBColor color)
 
 bool DeviceManager::UpdateDevice(int deviceIndex)
 {
-    if (!ValidateDeviceIndex(deviceIndex, Lightscape::DeviceType::RGB)) return false;
+    DeviceHandle device = ResolveDevice(deviceIndex);
+    return device.IsValid() && UpdateDevice(device);
+}
+
+bool DeviceManager::WriteDeviceColors(const DeviceHandle& device, Lightscape::ConstSpan<RGBColor> colors)
+{
+    if (!device.IsValid()) return false;
+    if (colors.isEmpty() || colors.size() > device.ledCount) {
+        SetError("Color count does not match the device");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::vector<RGBColor>& target = device.controller->colors;
+    if (colors.size() == 1) {
+        std::fill(target.begin(), target.begin() + device.ledCount, colors[0]);
+    } else {
+        std::copy(colors.begin(), colors.end(), target.begin());
+    }
+    return true;
+}
+
+bool DeviceManager::WriteZoneColors(const DeviceHandle& device, int zoneIndex, Lightscape::ConstSpan<RGBColor> colors)
+{
+    unsigned int start = 0;
+    unsigned int count = 0;
+    if (!GetZoneRange(device, zoneIndex, start, count)) return false;
+
+    if (colors.isEmpty() || (colors.size() != 1 && colors.size() > count)) {
+        SetError("Color count does not match the zone");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::vector<RGBColor>::iterator target = device.controller->colors.begin() + start;
+    if (colors.size() == 1) {
+        std::fill(target, target + count, colors[0]);
+    } else {
+        std::copy(colors.begin(), colors.end(), target);
+    }
+    return true;
+}
+
+bool DeviceManager::WriteLEDColors(const DeviceHandle& device, Lightscape::ConstSpan<int> ledIndices, Lightscape::ConstSpan<RGBColor> colors)
+{
+    if (!device.IsValid()) return false;
+    if (colors.isEmpty() || (colors.size() != 1 && colors.size() != ledIndices.size())) {
+        SetError("Color count does not match the LED list");
+        return false;
+    }
+
+    // Check the whole list first, so a bad index doesn't leave a half-written frame
+    for (int led : ledIndices) {
+        if (static_cast<unsigned int>(led) >= device.ledCount) {
+            SetError("LED index out of range");
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::vector<RGBColor>& target = device.controller->colors;
+    const size_t step = (colors.size() == 1) ? 0 : 1;
+    for (size_t i = 0; i < ledIndices.size(); i++) {
+        target[ledIndices[i]] = colors[i * step];
+    }
+    return true;
+}
+
+bool DeviceManager::UpdateDevice(const DeviceHandle& device)
+{
+    if (!device.IsValid()) return false;
 
     try {
-        auto& controllers = resourceManager->GetRGBControllers();
-        if (static_cast<size_t>(deviceIndex) < controllers.size()) {
-            auto controller = controllers[deviceIndex];
-            controller->UpdateLEDs();
-            emit deviceUpdated(deviceIndex, Lightscape::DeviceType::RGB);
+        device.controller->UpdateLEDs();
+        NotifyDeviceUpdated(device.index);
+        return true;
+    }
+    catch (...) {
+        SetError("Failed to update device");
+        return false;
+    }
+}
+
+bool DeviceManager::ColorWriteBatch::SetDevice(int deviceIndex, RGBColor color)
+{
+    DeviceHandle device = Resolve(deviceIndex);
+    return MarkWritten(device, manager && manager->WriteDeviceColors(device, Lightscape::ConstSpan<RGBColor>(&color, 1)));
+}
+
+bool DeviceManager::ColorWriteBatch::SetZone(int deviceIndex, int zoneIndex, RGBColor color)
+{
+    DeviceHandle device = Resolve(deviceIndex);
+    return MarkWritten(device, manager && manager->WriteZoneColors(device, zoneIndex, Lightscape::ConstSpan<RGBColor>(&color, 1)));
+}
+
+bool DeviceManager::ColorWriteBatch::SetLED(int deviceIndex, int ledIndex, RGBColor color)
+{
+    DeviceHandle device = Resolve(deviceIndex);
+    return MarkWritten(device, manager && manager->WriteLEDColors(device, Lightscape::ConstSpan<int>(&ledIndex, 1),
+                                                                  Lightscape::ConstSpan<RGBColor>(&color, 1)));
+}
+
+int DeviceManager::ColorWriteBatch::Commit()
+{
+    int updated = 0;
+    for (const DeviceHandle& device : touched) {
+        if (manager->UpdateDevice(device)) updated++;
+    }
+    touched.clear();
+    return updated;
+}
+
+DeviceHandle DeviceManager::ColorWriteBatch::Resolve(int deviceIndex) const
+{
+    // Batches touch a handful of devices; a scan beats a map here
+    for (const DeviceHandle& device : touched) {
+        if (device.index == deviceIndex) return device;
+    }
+    return manager ? manager->ResolveDevice(deviceIndex) : DeviceHandle();
+}
+
+bool DeviceManager::ColorWriteBatch::MarkWritten(const DeviceHandle& device, bool written)
+{
+    if (!written) return false;
+
+    for (const DeviceHandle& existing : touched) {
+        if (existing.index == device.index) return true;
+    }
+    touched.push_back(device);
+    return true;
+}
+
+bool DeviceManager::GetZoneRange(int deviceIndex, int zoneIndex, unsigned int& startIndex, unsigned int& ledCount) const
+{
+    DeviceHandle device = ResolveDevice(deviceIndex);
+    return device.IsValid() && GetZoneRange(device, zoneIndex, startIndex, ledCount);
+}
+
+bool DeviceManager::GetZoneRange(const DeviceHandle& device, int zoneIndex, unsigned int& startIndex, unsigned int& ledCount) const
+{
+    if (static_cast<unsigned int>(zoneIndex) >= device.zoneCount) {
+        SetError("Zone index out of range");
+        return false;
+    }
+
+    // Clamped to the LEDs the handle was resolved with
+    const zone& z = device.controller->zones[zoneIndex];
+    startIndex = std::min(z.start_idx, device.ledCount);
+    ledCount = std::min(z.leds_count, device.ledCount - startIndex);
+    return true;
+}
+
+bool DeviceManager::GetDeviceColors(int deviceIndex, std::vector<RGBColor>& colors) const
+{
+    DeviceHandle device = ResolveDevice(deviceIndex);
+    return device.IsValid() && GetDeviceColors(device, colors);
+}
+
+bool DeviceManager::GetDeviceColors(const DeviceHandle& device, std::vector<RGBColor>& colors) const
+{
+    if (!device.IsValid()) return false;
+
+    // Output workers copy frames into controller->colors under this lock
+    std::lock_guard<std::mutex> lock(outputMutex);
+    const std::vector<RGBColor>& source = device.controller->colors;
+
+    // assign() reuses the existing capacity, so steady-state frames don't allocate
+    colors.assign(source.begin(), source.begin() + device.ledCount);
+    return true;
+}
+
+bool DeviceManager::ApplyDeviceColors(int deviceIndex, const std::vector<RGBColor>& colors, bool* skipped)
+{
+    if (skipped) *skipped = false;
+    DeviceHandle device = ResolveDevice(deviceIndex);
+    return device.IsValid() && ApplyDeviceColors(device, colors, skipped);
+}
+
+bool DeviceManager::ApplyDeviceColors(const DeviceHandle& device, const std::vector<RGBColor>& colors, bool* skipped)
+{
+    if (skipped) *skipped = false;
+    if (!device.IsValid()) return false;
+
+    try {
+        RGBController* controller = device.controller;
+        size_t count = std::min<size_t>(colors.size(), device.ledCount);
+
+        std::unique_lock<std::mutex> lock(outputMutex);
+        SentFrame& sent = lastSentColors[device.index];
+
+        // Skip the bus transfer when this frame matches what the device already shows.
+        // Comparing against controller->colors too catches writes made outside the plugin.
+        bool sameController = (sent.controller == controller && sent.colors.size() == count);
+        if (sameController &&
+            std::equal(colors.begin(), colors.begin() + count, sent.colors.begin()) &&
+            std::equal(sent.colors.begin(), sent.colors.end(), controller->colors.begin())) {
+            skippedUpdates.fetch_add(1, std::memory_order_relaxed);
+            if (skipped) *skipped = true;
             return true;
         }
-        return false;
+
+        // When exactly one zone changed, update just that zone
+        int changedZone = -1;
+        if (sameController && controller->zones.size() > 1) {
+            int changedZones = 0;
+            for (size_t z = 0; z < controller->zones.size() && changedZones < 2; z++) {
+                size_t start = std::min<size_t>(controller->zones[z].start_idx, count);
+                size_t end = std::min<size_t>(start + controller->zones[z].leds_count, count);
+                if (!std::equal(colors.begin() + start, colors.begin() + end, controller->colors.begin() + start) ||
+                    !std::equal(sent.colors.begin() + start, sent.colors.begin() + end, controller->colors.begin() + start)) {
+                    changedZone = static_cast<int>(z);
+                    changedZones++;
+                }
+            }
+            if (changedZones != 1) changedZone = -1;
+        }
+
+        // Copy the whole frame, then push it to the hardware in a single update
+        std::copy(colors.begin(), colors.begin() + count, controller->colors.begin());
+        sent.controller = controller;
+        sent.colors.assign(colors.begin(), colors.begin() + count);
+
+        // The bus transfer runs unlocked, so a slow controller doesn't hold up the others
+        lock.unlock();
+
+        if (changedZone >= 0) {
+            controller->UpdateZoneLEDs(changedZone);
+            zoneUpdates.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            controller->UpdateLEDs();
+        }
+        sentUpdates.fetch_add(1, std::memory_order_relaxed);
+
+        NotifyDeviceUpdated(device.index);
+        return true;
     }
     catch (...) {
-        SetError("Failed to update device");
+        SetError("Failed to apply device colors");
         return false;
     }
 }
 
+bool DeviceManager::SubmitDeviceColors(const DeviceHandle& device, const std::vector<RGBColor>& colors)
+{
+    // A handle from before a rescan may name a controller the rescan dropped
+    if (device.generation != controllerGeneration.load()) return false;
+    return outputPool.Submit(device, colors);
+}
+
+bool DeviceManager::ApplyQueuedColors(const DeviceHandle& device, const std::vector<RGBColor>& colors)
+{
+    // Same check on the worker: the list may have changed while the frame waited
+    if (device.generation != controllerGeneration.load()) return false;
+
+    bool skipped = false;
+    return ApplyDeviceColors(device, colors, &skipped) && !skipped;
+}
+
+void DeviceManager::FlushOutput()
+{
+    outputPool.Flush();
+}
+
+void DeviceManager::ResetOutputStatistics()
+{
+    outputPool.ResetStatistics();
+    sentUpdates.store(0, std::memory_order_relaxed);
+    skippedUpdates.store(0, std::memory_order_relaxed);
+    zoneUpdates.store(0, std::memory_order_relaxed);
+}
+
 unsigned int DeviceManager::GetNonRGBDeviceCount() const
 {
     return nonRGBDevices.size();
@@ -346,8 +771,51 @@ bool DeviceManager::ValidateLEDIndex(int deviceIndex, int ledIndex) const
     return true;
 }
 
+void DeviceManager::SetNotificationInterval(int milliseconds)
+{
+    notificationTimer->setInterval(std::max(0, milliseconds));
+}
+
+int DeviceManager::GetNotificationInterval() const
+{
+    return notificationTimer->interval();
+}
+
+void DeviceManager::FlushNotifications()
+{
+    notificationTimer->stop();
+
+    DeviceNotificationSummary summary = notifier.TakeSummary();
+    if (summary.IsEmpty()) return;
+
+    emit notificationsReady(summary);
+    for (const QString& error : summary.errors) {
+        emit errorOccurred(error);
+    }
+}
+
+void DeviceManager::InitializeNotifications()
+{
+    qRegisterMetaType<DeviceNotificationSummary>();
+
+    notificationTimer = new QTimer(this);
+    notificationTimer->setSingleShot(true);
+    notificationTimer->setInterval(DefaultNotificationInterval);
+    connect(notificationTimer, &QTimer::timeout, this, &DeviceManager::FlushNotifications);
+}
+
+void DeviceManager::NotifyDeviceUpdated(int deviceIndex) const
+{
+    if (notifier.MarkUpdated(deviceIndex)) ScheduleNotifications();
+}
+
+void DeviceManager::ScheduleNotifications() const
+{
+    // Called from render and output threads; the timer lives in ours
+    QMetaObject::invokeMethod(notificationTimer, "start", Qt::QueuedConnection);
+}
+
 void DeviceManager::SetError(const QString& error) const
 {
-    lastError = error;
-    emit const_cast<DeviceManager*>(this)->errorOccurred(error);
+    if (notifier.ReportError(error)) ScheduleNotifications();
 }
\ No newline at end of file
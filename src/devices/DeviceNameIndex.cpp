@@ -0,0 +1,90 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| DeviceNameIndex.cpp                                       |
+|                                                           |
+| Hashed device, zone and LED name lookups                  |
+\*---------------------------------------------------------*/
+
+#include "devices/DeviceNameIndex.h"
+
+namespace {
+
+// Keeps the first index for a repeated name
+void indexNames(const QStringList& names, QHash<QString, int>& indices)
+{
+    indices.reserve(names.size());
+    for (int i = 0; i < names.size(); i++) {
+        if (!indices.contains(names.at(i))) {
+            indices.insert(names.at(i), i);
+        }
+    }
+}
+
+} // namespace
+
+void DeviceNameIndex::Rebuild(const std::vector<RGBController*>& controllers, quint64 newGeneration)
+{
+    generation = newGeneration;
+    devices.clear();
+    deviceIndices.clear();
+    devices.reserve(static_cast<int>(controllers.size()));
+
+    for (RGBController* controller : controllers) {
+        DeviceNames entry;
+        entry.name = QString::fromStdString(controller->name);
+
+        entry.zones.reserve(static_cast<int>(controller->zones.size()));
+        for (const zone& z : controller->zones) {
+            entry.zones.append(QString::fromStdString(z.name));
+        }
+
+        entry.leds.reserve(static_cast<int>(controller->leds.size()));
+        for (const led& l : controller->leds) {
+            entry.leds.append(QString::fromStdString(l.name));
+        }
+
+        indexNames(entry.zones, entry.zoneIndices);
+        indexNames(entry.leds, entry.ledIndices);
+
+        if (!deviceIndices.contains(entry.name)) {
+            deviceIndices.insert(entry.name, devices.size());
+        }
+        devices.append(entry);
+    }
+}
+
+int DeviceNameIndex::FindDevice(const QString& name) const
+{
+    return deviceIndices.value(name, -1);
+}
+
+int DeviceNameIndex::FindZone(int deviceIndex, const QString& name) const
+{
+    if (deviceIndex < 0 || deviceIndex >= devices.size()) return -1;
+    return devices.at(deviceIndex).zoneIndices.value(name, -1);
+}
+
+int DeviceNameIndex::FindLED(int deviceIndex, const QString& name) const
+{
+    if (deviceIndex < 0 || deviceIndex >= devices.size()) return -1;
+    return devices.at(deviceIndex).ledIndices.value(name, -1);
+}
+
+QString DeviceNameIndex::DeviceName(int deviceIndex) const
+{
+    if (deviceIndex < 0 || deviceIndex >= devices.size()) return QString();
+    return devices.at(deviceIndex).name;
+}
+
+QString DeviceNameIndex::ZoneName(int deviceIndex, int zoneIndex) const
+{
+    if (deviceIndex < 0 || deviceIndex >= devices.size()) return QString();
+    return devices.at(deviceIndex).zones.value(zoneIndex);
+}
+
+QString DeviceNameIndex::LEDName(int deviceIndex, int ledIndex) const
+{
+    if (deviceIndex < 0 || deviceIndex >= devices.size()) return QString();
+    return devices.at(deviceIndex).leds.value(ledIndex);
+}
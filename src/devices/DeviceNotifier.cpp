@@ -0,0 +1,94 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| DeviceNotifier.cpp                                        |
+|                                                           |
+| Coalesces device updates and errors between UI refreshes  |
+\*---------------------------------------------------------*/
+
+#include "devices/DeviceNotifier.h"
+
+bool DeviceNotifier::MarkUpdated(int deviceIndex)
+{
+    if (deviceIndex < 0) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (static_cast<size_t>(deviceIndex) >= deviceSerials.size()) {
+        deviceSerials.resize(deviceIndex + 1, 0);
+    }
+
+    quint64 next = serial.load(std::memory_order_relaxed) + 1;
+    deviceSerials[deviceIndex] = next;
+    serial.store(next, std::memory_order_release);
+    pendingUpdates++;
+
+    return MarkPendingLocked();
+}
+
+bool DeviceNotifier::ReportError(const QString& error)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    lastError = error;
+
+    int existing = pendingErrors.indexOf(error);
+    if (existing >= 0) {
+        pendingErrorCounts[existing]++;
+    } else if (pendingErrors.size() < MaxDistinctErrors) {
+        pendingErrors.append(error);
+        pendingErrorCounts.append(1);
+    } else {
+        droppedErrors++;
+    }
+
+    return MarkPendingLocked();
+}
+
+DeviceNotificationSummary DeviceNotifier::TakeSummary()
+{
+    DeviceNotificationSummary summary;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    summary.serial = serial.load(std::memory_order_relaxed);
+    summary.updatedDevices = UpdatedSinceLocked(summarySerial);
+    summary.updateCount = pendingUpdates;
+    summary.errors.swap(pendingErrors);
+    summary.errorCounts.swap(pendingErrorCounts);
+    summary.droppedErrors = droppedErrors;
+
+    summarySerial = summary.serial;
+    pendingUpdates = 0;
+    droppedErrors = 0;
+    pending = false;
+    return summary;
+}
+
+QList<int> DeviceNotifier::GetUpdatedSince(quint64 since) const
+{
+    // Nothing new: skip the lock, this is what most polls find
+    if (serial.load(std::memory_order_acquire) <= since) return QList<int>();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return UpdatedSinceLocked(since);
+}
+
+QString DeviceNotifier::GetLastError() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastError;
+}
+
+QList<int> DeviceNotifier::UpdatedSinceLocked(quint64 since) const
+{
+    QList<int> devices;
+    for (size_t i = 0; i < deviceSerials.size(); i++) {
+        if (deviceSerials[i] > since) devices.append(static_cast<int>(i));
+    }
+    return devices;
+}
+
+bool DeviceNotifier::MarkPendingLocked()
+{
+    if (pending) return false;
+    pending = true;
+    return true;
+}
@@ -0,0 +1,254 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| DeviceOutputPool.cpp                                      |
+|                                                           |
+| Per-controller output threads with latest-frame mailboxes |
+\*---------------------------------------------------------*/
+
+#include "devices/DeviceOutputPool.h"
+#include <algorithm>
+
+namespace {
+
+const std::chrono::seconds RateWindow(1);
+
+// Write times a worker holds for TakeWriteTimes(); older ones are dropped
+const size_t MaxUnreportedWrites = 64;
+
+} // namespace
+
+DeviceOutputPool::DeviceOutputPool(Writer writer)
+    : writer(std::move(writer))
+{
+}
+
+DeviceOutputPool::~DeviceOutputPool()
+{
+    Stop();
+}
+
+bool DeviceOutputPool::Submit(const DeviceHandle& device, const std::vector<RGBColor>& colors)
+{
+    if (!device.IsValid()) return false;
+
+    std::shared_ptr<Worker> worker;
+    {
+        std::lock_guard<std::mutex> lock(workersMutex);
+        std::shared_ptr<Worker>& slot = workers[device.controller];
+        if (!slot) {
+            slot.reset(new Worker());
+            slot->stats.controller = device.controller;
+            slot->windowStart = Clock::now();
+            slot->unreported.reserve(MaxUnreportedWrites);
+            slot->thread = std::thread(&DeviceOutputPool::Run, this, slot.get());
+        }
+        worker = slot;
+    }
+
+    bool replaced = false;
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+
+        // Retired by a rescan after we looked it up: its controller is gone
+        if (worker->stopping) return false;
+        replaced = worker->hasPending;
+
+        // assign() keeps the slot's capacity; the worker swaps buffers rather than copying
+        worker->pendingDevice = device;
+        worker->pending.assign(colors.begin(), colors.end());
+        worker->hasPending = true;
+
+        worker->stats.deviceIndex = device.index;
+        worker->stats.submitted++;
+        if (replaced) worker->stats.dropped++;
+    }
+    worker->wake.notify_one();
+
+    return replaced;
+}
+
+void DeviceOutputPool::Retain(const std::vector<DeviceHandle>& devices, RetiredWorkers& retired)
+{
+    std::lock_guard<std::mutex> lock(workersMutex);
+    for (auto it = workers.begin(); it != workers.end();) {
+        bool present = std::any_of(devices.begin(), devices.end(), [&](const DeviceHandle& device) {
+            return device.controller == it->first;
+        });
+        if (present) {
+            ++it;
+        } else {
+            // Only signalled here; the join waits for a write in progress
+            SignalStop(it->second.get(), true);
+            retired.workers.push_back(std::move(it->second));
+            it = workers.erase(it);
+        }
+    }
+}
+
+DeviceOutputPool::RetiredWorkers::~RetiredWorkers()
+{
+    for (const std::shared_ptr<Worker>& worker : workers) {
+        JoinWorker(worker.get());
+    }
+}
+
+void DeviceOutputPool::Flush()
+{
+    std::vector<std::shared_ptr<Worker>> flushing;
+    {
+        std::lock_guard<std::mutex> lock(workersMutex);
+        flushing.reserve(workers.size());
+        for (auto& entry : workers) {
+            flushing.push_back(entry.second);
+        }
+    }
+
+    // Waited on outside the lock, as in Stop(), so a slow controller doesn't hold
+    // up Submit() for the others; a worker retired meanwhile still ends idle
+    for (const std::shared_ptr<Worker>& entry : flushing) {
+        Worker* worker = entry.get();
+        std::unique_lock<std::mutex> workerLock(worker->mutex);
+        worker->idle.wait(workerLock, [worker]() { return !worker->hasPending && !worker->writing; });
+    }
+}
+
+void DeviceOutputPool::Stop()
+{
+    std::map<RGBController*, std::shared_ptr<Worker>> stopped;
+    {
+        std::lock_guard<std::mutex> lock(workersMutex);
+        stopped.swap(workers);
+    }
+
+    for (auto& entry : stopped) {
+        StopWorker(entry.second.get(), false);
+    }
+}
+
+std::vector<DeviceOutputPool::ControllerStatistics> DeviceOutputPool::GetStatistics() const
+{
+    std::vector<ControllerStatistics> result;
+    Clock::time_point now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(workersMutex);
+    result.reserve(workers.size());
+    for (const auto& entry : workers) {
+        const Worker* worker = entry.second.get();
+        std::lock_guard<std::mutex> workerLock(worker->mutex);
+        ControllerStatistics stats = worker->stats;
+
+        // A controller that stopped receiving frames doesn't roll its window over
+        std::chrono::duration<double> elapsed = now - worker->windowStart;
+        if (elapsed > 2 * RateWindow) {
+            stats.fps = worker->windowWrites / elapsed.count();
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+void DeviceOutputPool::ResetStatistics()
+{
+    std::lock_guard<std::mutex> lock(workersMutex);
+    for (auto& entry : workers) {
+        Worker* worker = entry.second.get();
+        std::lock_guard<std::mutex> workerLock(worker->mutex);
+
+        ControllerStatistics stats;
+        stats.controller = worker->stats.controller;
+        stats.deviceIndex = worker->stats.deviceIndex;
+        worker->stats = stats;
+        worker->windowStart = Clock::now();
+        worker->windowWrites = 0;
+        worker->windowWriteTime = Clock::duration::zero();
+        worker->unreported.clear();
+    }
+}
+
+void DeviceOutputPool::TakeWriteTimes(std::vector<WriteTime>& times)
+{
+    std::lock_guard<std::mutex> lock(workersMutex);
+    for (auto& entry : workers) {
+        Worker* worker = entry.second.get();
+        std::lock_guard<std::mutex> workerLock(worker->mutex);
+        times.insert(times.end(), worker->unreported.begin(), worker->unreported.end());
+        worker->unreported.clear();
+    }
+}
+
+void DeviceOutputPool::Run(Worker* worker)
+{
+    DeviceHandle device;
+    std::vector<RGBColor> frame;
+    std::unique_lock<std::mutex> lock(worker->mutex);
+
+    while (true) {
+        worker->wake.wait(lock, [worker]() { return worker->hasPending || worker->stopping; });
+
+        if (!worker->hasPending) break;
+
+        // Take the newest frame and leave our old buffer in the slot for reuse
+        device = worker->pendingDevice;
+        frame.swap(worker->pending);
+        worker->hasPending = false;
+        worker->writing = true;
+
+        lock.unlock();
+        Clock::time_point start = Clock::now();
+        bool written = writer(device, frame);
+        Clock::time_point end = Clock::now();
+        lock.lock();
+
+        worker->writing = false;
+        worker->stats.written++;
+        worker->windowWrites++;
+        worker->windowWriteTime += end - start;
+
+        // Skipped frames never reached UpdateLEDs, so they say nothing about the bus
+        if (written) {
+            if (worker->unreported.size() >= MaxUnreportedWrites) {
+                worker->unreported.erase(worker->unreported.begin());
+            }
+            worker->unreported.push_back({ device.index, end - start });
+        }
+
+        std::chrono::duration<double> elapsed = end - worker->windowStart;
+        if (elapsed >= RateWindow) {
+            worker->stats.fps = worker->windowWrites / elapsed.count();
+            worker->stats.writeMs = std::chrono::duration<double, std::milli>(worker->windowWriteTime).count() / worker->windowWrites;
+            worker->windowStart = end;
+            worker->windowWrites = 0;
+            worker->windowWriteTime = Clock::duration::zero();
+        }
+
+        if (!worker->hasPending) {
+            worker->idle.notify_all();
+        }
+    }
+
+    worker->idle.notify_all();
+}
+
+void DeviceOutputPool::SignalStop(Worker* worker, bool discardPending)
+{
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (discardPending) worker->hasPending = false;
+        worker->stopping = true;
+    }
+    worker->wake.notify_all();
+}
+
+void DeviceOutputPool::JoinWorker(Worker* worker)
+{
+    if (worker->thread.joinable()) {
+        worker->thread.join();
+    }
+}
+
+void DeviceOutputPool::StopWorker(Worker* worker, bool discardPending)
+{
+    SignalStop(worker, discardPending);
+    JoinWorker(worker);
+}
@@ -0,0 +1,405 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| MockControllerBackend.cpp                                 |
+|                                                           |
+| In-process stand-in controllers with simulated latency    |
+\*---------------------------------------------------------*/
+
+#include "devices/MockControllerBackend.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+std::string trimmed(const std::string& text)
+{
+    size_t first = 0;
+    size_t last = text.size();
+    while (first < last && std::isspace(static_cast<unsigned char>(text[first]))) first++;
+    while (last > first && std::isspace(static_cast<unsigned char>(text[last - 1]))) last--;
+    return text.substr(first, last - first);
+}
+
+bool parseInt(const std::string& text, int& value)
+{
+    if (text.empty()) return false;
+    char* end = nullptr;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (*end != '\0' || parsed <= 0 || parsed > 65536) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+bool parseMilliseconds(const std::string& text, std::chrono::microseconds& value)
+{
+    if (text.empty()) return false;
+    char* end = nullptr;
+    double parsed = std::strtod(text.c_str(), &end);
+    if (*end != '\0' || parsed < 0.0 || parsed > 60000.0) return false;
+    value = std::chrono::microseconds(static_cast<long long>(parsed * 1000.0));
+    return true;
+}
+
+// "32" or "4x32"; a single number fills the first value
+bool parseSize(const std::string& text, int& first, int& second)
+{
+    size_t x = text.find('x');
+    if (x == std::string::npos) return parseInt(text, first);
+    return parseInt(text.substr(0, x), first) && parseInt(text.substr(x + 1), second);
+}
+
+const char* topologyName(MockTopology topology)
+{
+    switch (topology) {
+        case MockTopology::Linear: return "Linear";
+        case MockTopology::Matrix: return "Matrix";
+        case MockTopology::Single: return "Single";
+    }
+    return "";
+}
+
+} // namespace
+
+int MockControllerSpec::GetLEDCount() const
+{
+    switch (topology) {
+        case MockTopology::Linear: return zones * width;
+        case MockTopology::Matrix: return width * height;
+        case MockTopology::Single: return zones;
+    }
+    return 0;
+}
+
+MockWriteLog::MockWriteLog(size_t capacity)
+    : entries(capacity)
+{
+}
+
+void MockWriteLog::Record(const Entry& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!entries.empty()) {
+        entries[next] = entry;
+        next = (next + 1) % entries.size();
+        count = std::min(count + 1, entries.size());
+    }
+
+    if (entry.controllerId >= static_cast<int>(controllerTotals.size())) {
+        controllerTotals.resize(entry.controllerId + 1);
+    }
+    for (Totals* target : { &totals, &controllerTotals[entry.controllerId] }) {
+        target->writes++;
+        target->busy += entry.duration;
+        target->longest = std::max(target->longest, entry.duration);
+    }
+}
+
+void MockWriteLog::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    next = 0;
+    count = 0;
+    controllerTotals.clear();
+    totals = Totals();
+}
+
+std::vector<MockWriteLog::Entry> MockWriteLog::GetEntries() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Oldest first: before a wrap that's slot 0, afterwards the next one to be overwritten
+    std::vector<Entry> result;
+    result.reserve(count);
+    size_t first = (next + entries.size() - count) % std::max<size_t>(entries.size(), 1);
+    for (size_t i = 0; i < count; i++) {
+        result.push_back(entries[(first + i) % entries.size()]);
+    }
+    return result;
+}
+
+MockWriteLog::Totals MockWriteLog::GetTotals() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return totals;
+}
+
+MockWriteLog::Totals MockWriteLog::GetTotals(int controllerId) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (controllerId < 0 || controllerId >= static_cast<int>(controllerTotals.size())) return Totals();
+    return controllerTotals[controllerId];
+}
+
+MockController::MockController(int controllerId, const MockControllerSpec& spec, MockWriteLog* log)
+    : controllerId(controllerId)
+    , spec(spec)
+    , log(log)
+    , random(static_cast<std::mt19937::result_type>(controllerId + 1))
+{
+    name        = spec.name.empty() ? std::string("Mock ") + topologyName(spec.topology) + " " + std::to_string(controllerId)
+                                    : spec.name;
+    description = "Lightscape mock controller";
+    location    = "mock:" + std::to_string(controllerId);
+    type        = spec.topology == MockTopology::Matrix ? DEVICE_TYPE_KEYBOARD : DEVICE_TYPE_LEDSTRIP;
+
+    mode direct;
+    direct.name       = "Direct";
+    direct.value      = 0;
+    direct.flags      = MODE_FLAG_HAS_PER_LED_COLOR;
+    direct.color_mode = MODE_COLORS_PER_LED;
+    modes.push_back(direct);
+
+    const int zoneCount = spec.topology == MockTopology::Matrix ? 1 : spec.zones;
+    for (int z = 0; z < zoneCount; z++) {
+        zone new_zone;
+        new_zone.name       = "Zone " + std::to_string(z);
+        new_zone.matrix_map = nullptr;
+
+        unsigned int ledCount = 1;
+        switch (spec.topology) {
+            case MockTopology::Linear:
+                new_zone.type = ZONE_TYPE_LINEAR;
+                ledCount = spec.width;
+                break;
+
+            case MockTopology::Matrix:
+                new_zone.type = ZONE_TYPE_MATRIX;
+                ledCount = spec.width * spec.height;
+                new_zone.matrix_map = new matrix_map_type;
+                new_zone.matrix_map->width  = spec.width;
+                new_zone.matrix_map->height = spec.height;
+                new_zone.matrix_map->map    = new unsigned int[ledCount];
+                for (unsigned int i = 0; i < ledCount; i++) {
+                    new_zone.matrix_map->map[i] = i;
+                }
+                break;
+
+            case MockTopology::Single:
+                new_zone.type = ZONE_TYPE_SINGLE;
+                break;
+        }
+
+        new_zone.leds_min   = ledCount;
+        new_zone.leds_max   = ledCount;
+        new_zone.leds_count = ledCount;
+        zones.push_back(new_zone);
+
+        for (unsigned int l = 0; l < ledCount; l++) {
+            led new_led;
+            new_led.name = new_zone.name + " LED " + std::to_string(l);
+            leds.push_back(new_led);
+        }
+    }
+
+    SetupColors();
+}
+
+MockController::~MockController()
+{
+    for (zone& z : zones) {
+        if (z.matrix_map) {
+            delete[] z.matrix_map->map;
+            delete z.matrix_map;
+            z.matrix_map = nullptr;
+        }
+    }
+}
+
+void MockController::DeviceUpdateLEDs()
+{
+    Simulate(MockWriteLog::Kind::Device, -1);
+}
+
+void MockController::UpdateZoneLEDs(int zone)
+{
+    Simulate(MockWriteLog::Kind::Zone, zone);
+}
+
+void MockController::UpdateSingleLED(int led)
+{
+    Simulate(MockWriteLog::Kind::SingleLED, led);
+}
+
+quint64 MockController::GetUpdateCount() const
+{
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    return updateCount;
+}
+
+void MockController::SetLatency(std::chrono::microseconds latency, std::chrono::microseconds jitter)
+{
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    spec.latency = latency;
+    spec.jitter = jitter;
+}
+
+void MockController::Simulate(MockWriteLog::Kind kind, int target)
+{
+    std::chrono::microseconds delay;
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex);
+        delay = spec.latency;
+        if (spec.jitter.count() > 0) {
+            std::uniform_int_distribution<long long> extra(0, spec.jitter.count());
+            delay += std::chrono::microseconds(extra(random));
+        }
+        updateCount++;
+    }
+
+    MockWriteLog::Entry entry;
+    entry.controllerId = controllerId;
+    entry.kind = kind;
+    entry.target = target;
+    entry.start = MockWriteLog::Clock::now();
+
+    // Blocks the caller like a bus transfer would; zero latency doesn't yield
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+
+    entry.duration = MockWriteLog::Clock::now() - entry.start;
+    if (log) log->Record(entry);
+}
+
+MockControllerBackend::MockControllerBackend()
+{
+}
+
+MockControllerBackend::MockControllerBackend(const std::vector<MockControllerSpec>& specs)
+{
+    for (const MockControllerSpec& spec : specs) {
+        AddController(spec);
+    }
+}
+
+MockControllerBackend::~MockControllerBackend()
+{
+    for (RGBController* controller : controllers) {
+        delete controller;
+    }
+}
+
+bool MockControllerBackend::ParseSpecs(const std::string& text, std::vector<MockControllerSpec>& specs,
+                                       std::string* error)
+{
+    std::vector<MockControllerSpec> parsed;
+    std::stringstream stream(text);
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        const std::string original = trimmed(item);
+        if (original.empty()) continue;
+
+        std::string entry = original;
+        auto fail = [&](const char* reason) {
+            if (error) *error = "\"" + original + "\": " + reason;
+            return false;
+        };
+
+        int count = 1;
+        size_t star = entry.find('*');
+        if (star != std::string::npos) {
+            if (!parseInt(entry.substr(0, star), count)) return fail("invalid count");
+            entry = entry.substr(star + 1);
+        }
+
+        MockControllerSpec spec;
+        size_t at = entry.find('@');
+        if (at != std::string::npos) {
+            std::string timing = entry.substr(at + 1);
+            size_t tilde = timing.find('~');
+            if (!parseMilliseconds(timing.substr(0, tilde), spec.latency)) return fail("invalid latency");
+            if (tilde != std::string::npos && !parseMilliseconds(timing.substr(tilde + 1), spec.jitter)) {
+                return fail("invalid jitter");
+            }
+            entry = entry.substr(0, at);
+        }
+
+        std::string size;
+        size_t colon = entry.find(':');
+        if (colon != std::string::npos) {
+            size = entry.substr(colon + 1);
+            entry = entry.substr(0, colon);
+        }
+
+        if (entry == "linear") {
+            spec.topology = MockTopology::Linear;
+            spec.zones = 1;
+            spec.width = 32;
+            // "32" is one zone of 32 LEDs, "4x32" four of them
+            if (!size.empty()) {
+                int first = 0, second = 0;
+                if (!parseSize(size, first, second)) return fail("invalid size");
+                if (second > 0) {
+                    spec.zones = first;
+                    spec.width = second;
+                } else {
+                    spec.width = first;
+                }
+            }
+        } else if (entry == "matrix") {
+            spec.topology = MockTopology::Matrix;
+            spec.width = 22;
+            spec.height = 6;
+            if (!size.empty() && (!parseSize(size, spec.width, spec.height) || size.find('x') == std::string::npos)) {
+                return fail("matrix size must be WxH");
+            }
+        } else if (entry == "single") {
+            spec.topology = MockTopology::Single;
+            spec.zones = 1;
+            if (!size.empty() && !parseInt(size, spec.zones)) return fail("invalid zone count");
+        } else {
+            return fail("topology must be linear, matrix or single");
+        }
+
+        parsed.insert(parsed.end(), count, spec);
+    }
+
+    if (parsed.empty()) {
+        if (error) *error = "no controllers";
+        return false;
+    }
+
+    specs = parsed;
+    return true;
+}
+
+MockController* MockControllerBackend::AddController(const MockControllerSpec& spec)
+{
+    std::lock_guard<std::mutex> lock(controllersMutex);
+    MockController* controller = new MockController(nextControllerId++, spec, &writeLog);
+    controllers.push_back(controller);
+    return controller;
+}
+
+std::unique_ptr<MockController> MockControllerBackend::RemoveController(int index)
+{
+    std::lock_guard<std::mutex> lock(controllersMutex);
+    if (index < 0 || index >= static_cast<int>(controllers.size())) return nullptr;
+
+    std::unique_ptr<MockController> removed(static_cast<MockController*>(controllers[index]));
+    controllers.erase(controllers.begin() + index);
+    return removed;
+}
+
+MockController* MockControllerBackend::GetController(int index) const
+{
+    std::lock_guard<std::mutex> lock(controllersMutex);
+    if (index < 0 || index >= static_cast<int>(controllers.size())) return nullptr;
+    return static_cast<MockController*>(controllers[index]);
+}
+
+size_t MockControllerBackend::GetTotalLEDCount() const
+{
+    std::lock_guard<std::mutex> lock(controllersMutex);
+    size_t total = 0;
+    for (const RGBController* controller : controllers) {
+        total += controller->colors.size();
+    }
+    return total;
+}
@@ -1,6 +1,9 @@
 #include "effects/BaseEffect.h"
 #include "devices/DeviceManager.h"
 #include "effects/SpatialControllerZone.h"
+#include "effects/FrameCompositor.h"
+#include "effects/ColorScale.h"
+#include "core/LoggingManager.h"
 #include <cmath>
 
 namespace Lightscape {
@@ -13,6 +16,8 @@ BaseEffect::BaseEffect(QWidget* parent)
     
     // Initialize with a default color if none provided
     userColors.append(ToRGBColor(255, 0, 0)); // Default red
+    publishParameters();
+    frameParameters = parameters();
 }
 
 void BaseEffect::initialize(::DeviceManager* manager, ::SpatialGrid* grid)
@@ -29,13 +34,26 @@ void BaseEffect::initialize(::DeviceManager* manager, ::SpatialGrid* grid)
             referencePoint = userPos.value();
         }
     }
+    
+    publishParameters();
+    frameParameters = parameters();
 }
 
 void BaseEffect::update(float deltaTime)
 {
+    // One settings snapshot per frame, so a frame never mixes old and new values
+    frameParameters = parameters();
+    frameArena.reset();
+    
+    // One cache lookup per frame; built again only after the layout changed
+    if (spatialGrid) {
+        frameField = spatialGrid->GetSpatialField(frameParameters.referencePoint);
+    }
+    
     // Update time - actual effects will override this with more specific behavior
     if (isEnabled) {
-        time += deltaTime * (speed / 50.0f); // Normalize speed
+        time += deltaTime * (frameParameters.speed / 50.0f); // Normalize speed
+        _sharedTime.store(time, std::memory_order_relaxed);
     }
 }
 
@@ -52,60 +70,64 @@ void BaseEffect::stop()
 void BaseEffect::applyToDevices(const QList<DeviceInfo>& devices)
 {
     if (!deviceManager) {
-        printf("[Lightscape][BaseEffect] ERROR: deviceManager is null\n");
+        LOG_THROTTLED(LogLevel::Error, "[Lightscape][BaseEffect] deviceManager is null");
         return;
     }
     
+    // Render into a one-off frame buffer so each controller is updated only once
+    std::vector<DeviceInfo> deviceList(devices.begin(), devices.end());
+    FrameCompositor compositor(deviceManager);
+    compositor.beginFrame();
+    renderToCompositor(deviceList, compositor);
+    compositor.flush();
+}
+
+void BaseEffect::renderToCompositor(ConstSpan<DeviceInfo> devices, FrameCompositor& compositor)
+{
     if (!isEnabled) {
-        printf("[Lightscape][BaseEffect] Effect not enabled, not applying colors\n");
+        LOG_TRACE("[Lightscape][BaseEffect] Effect not enabled, not applying colors");
         return;
     }
     
-    printf("[Lightscape][BaseEffect] Applying effect to %d devices (effect: %s)\n", 
-           devices.size(), 
-           GetStaticInfo().name.toStdString().c_str());
+    LOG_TRACE("[Lightscape][BaseEffect] Applying effect to %d devices (effect: %s)", 
+              static_cast<int>(devices.size()), 
+              qPrintable(GetStaticInfo().name));
     
-    // Apply the effect to each device based on its position
+    // Evaluate every device position in one batch call
+    frameBatch.clear();
+    for (const DeviceInfo& device : devices) {
+        frameBatch.append(device.position);
+    }
+    evaluateFrameBatch(time);
+    
+    // Apply the effect to each device based on its position (brightness is already applied)
     int successCount = 0;
     
-    for (const DeviceInfo& device : devices) {
-        RGBColor color = getColorForPosition(device.position, time);
+    for (size_t i = 0; i < devices.size(); i++) {
+        const DeviceInfo& device = devices[i];
+        RGBColor color = frameColors[i];
         
-        // Apply brightness
-        float brightnessValue = brightness / 100.0f;
-        color = applyBrightness(color, brightnessValue);
+        LOG_TRACE("[Lightscape][BaseEffect] Applying color RGB(%d,%d,%d) to device idx:%d pos:(%d,%d,%d)", 
+                  static_cast<int>(RGBGetRValue(color)), static_cast<int>(RGBGetGValue(color)), static_cast<int>(RGBGetBValue(color)),
+                  device.index, device.position.x, device.position.y, device.position.z);
         
-        // Debug color values
-        int r = static_cast<int>(RGBGetRValue(color));
-        int g = static_cast<int>(RGBGetGValue(color));
-        int b = static_cast<int>(RGBGetBValue(color));
-        
-        printf("[Lightscape][BaseEffect] Applying color RGB(%d,%d,%d) to device idx:%d pos:(%d,%d,%d)\n", 
-               r, g, b, device.index, device.position.x, device.position.y, device.position.z);
-        
-        // Apply the color based on device specifics
+        // Write the color into the frame buffer, the compositor pushes it to the hardware
         bool success = false;
         
         if (device.type == DeviceType::RGB) {
             if (device.ledIndex >= 0) {
                 // Set specific LED
-                success = deviceManager->SetLEDColor(device.index, device.ledIndex, color);
-                printf("[Lightscape][BaseEffect] Setting LED %d color: %s\n", device.ledIndex, success ? "SUCCESS" : "FAILED");
+                success = compositor.setLED(device.index, device.ledIndex, color);
             }
             else if (device.zoneIndex >= 0) {
                 // Set specific zone
-                success = deviceManager->SetZoneColor(device.index, device.zoneIndex, color);
-                printf("[Lightscape][BaseEffect] Setting zone %d color: %s\n", device.zoneIndex, success ? "SUCCESS" : "FAILED");
+                success = compositor.setZone(device.index, device.zoneIndex, color);
             }
             else {
                 // Set whole device
-                success = deviceManager->SetDeviceColor(device.index, color);
-                printf("[Lightscape][BaseEffect] Setting device %d color: %s\n", device.index, success ? "SUCCESS" : "FAILED");
+                success = compositor.setDevice(device.index, color);
             }
             
-            // Explicitly force an update to the device
-            deviceManager->UpdateDevice(device.index);
-            
             if (success) {
                 successCount++;
             }
@@ -113,12 +135,12 @@ void BaseEffect::applyToDevices(const QList<DeviceInfo>& devices)
         // Could add support for non-RGB devices in the future
     }
     
-    printf("[Lightscape][BaseEffect] Successfully applied colors to %d/%d devices\n", successCount, devices.size());
+    LOG_TRACE("[Lightscape][BaseEffect] Successfully applied colors to %d/%d devices", successCount, static_cast<int>(devices.size()));
 }
 
 void BaseEffect::loadSettings(const QJsonObject& json)
 {
-    // Load basic effect settings
+    // Load basic effect settings (published in one block at the end)
     if (json.contains("speed")) {
         speed = json["speed"].toInt();
     }
@@ -155,8 +177,10 @@ void BaseEffect::loadSettings(const QJsonObject& json)
                 userColors.append(color);
             }
         }
+        clampUserColors();
     }
     
+    publishParameters();
     emit settingsChanged();
 }
 
@@ -190,37 +214,102 @@ QJsonObject BaseEffect::saveSettings() const
     return json;
 }
 
+void BaseEffect::getColorsForPositions(const PositionBatch& positions, float time,
+                                       const EffectParameters& params, RGBColor* colors)
+{
+    // Default implementation: one virtual call per position. Effects that only
+    // implement getColorForPosition should read their settings via parameters().
+    Q_UNUSED(params);
+    size_t count = positions.size();
+    for (size_t i = 0; i < count; i++) {
+        colors[i] = getColorForPosition(positions.at(i), time);
+    }
+}
+
+void BaseEffect::getOutputColors(const PositionBatch& positions, float time,
+                                 const EffectParameters& params, RGBColor* colors)
+{
+    if (positions.isEmpty()) return;
+    
+    getColorsForPositions(positions, time, params, colors);
+    scaleColors(colors, colors, positions.size(), params.brightness);
+}
+
+void BaseEffect::evaluateFrameBatch(float time)
+{
+    frameColors.resize(frameBatch.size());
+    getOutputColors(frameBatch, time, frameParameters, frameColors.data());
+}
+
+void BaseEffect::setColors(const QList<RGBColor>& colors)
+{
+    userColors = colors;
+    clampUserColors();
+    publishParameters();
+}
+
+void BaseEffect::clampUserColors()
+{
+    // The renderer only sees MaxColors; keep the list the UI shows and saves the same
+    if (userColors.size() > EffectParameters::MaxColors) {
+        LOG_WARNING(QString("[Lightscape][BaseEffect] %1 colors given, keeping the first %2")
+                    .arg(userColors.size()).arg(EffectParameters::MaxColors));
+        userColors = userColors.mid(0, EffectParameters::MaxColors);
+    }
+}
+
+void BaseEffect::publishParameters()
+{
+    EffectParameters params;
+    params.speed = speed;
+    params.brightness = brightness;
+    params.fps = fps;
+    params.randomColors = randomColorsEnabled;
+    params.referencePoint = referencePoint;
+    params.setColors(userColors);
+    
+    _publishedParameters.store(params);
+}
+
 float BaseEffect::calculateDistance(const GridPosition& pos1, const GridPosition& pos2) const
 {
+    // Distances to this frame's reference point are a table lookup
+    if (frameField && pos2 == frameField->GetReference()) {
+        return frameField->GetDistance(pos1);
+    }
+    
     float dx = pos1.x - pos2.x;
     float dy = pos1.y - pos2.y;
     float dz = pos1.z - pos2.z;
     return std::sqrt(dx*dx + dy*dy + dz*dz);
 }
 
+std::shared_ptr<const SpatialField> BaseEffect::getReferenceField(const GridPosition& reference) const
+{
+    if (!spatialGrid) return nullptr;
+    return spatialGrid->GetSpatialField(reference);
+}
+
 RGBColor BaseEffect::applyBrightness(const RGBColor& color, float brightnessFactor) const
 {
-    // Clamp brightness to reasonable values
-    float clampedBrightness = std::max(0.0f, std::min(1.0f, brightnessFactor));
-    
-    // Apply brightness to each component
-    int r = static_cast<int>(RGBGetRValue(color) * clampedBrightness);
-    int g = static_cast<int>(RGBGetGValue(color) * clampedBrightness);
-    int b = static_cast<int>(RGBGetBValue(color) * clampedBrightness);
-    
-    return ToRGBColor(r, g, b);
+    // Same fixed-point tables as the frame path (scaleColor clamps to 0-100)
+    return scaleColor(color, static_cast<int>(std::lround(brightnessFactor * 100.0f)));
 }
 
-void BaseEffect::StepEffect(std::vector<ControllerZone*> zones)
+void BaseEffect::StepEffect(ConstSpan<ControllerZone*> zones)
 {
     if (!isEnabled) return;
     
     // Increment time - this may be overridden by derived classes
-    time += 1.0f / fps * (speed / 50.0f);
+    time += 1.0f / frameParameters.fps * (frameParameters.speed / 50.0f);
+    _sharedTime.store(time, std::memory_order_relaxed);
     
-    // Process zones based on whether they have spatial data
-    std::vector<ControllerZone*> spatialZones;
-    std::vector<ControllerZone*> nonSpatialZones;
+    // Process zones based on whether they have spatial data; the lists live in
+    // the frame arena, so steady-state frames don't allocate
+    Span<ControllerZone*> spatialZones = frameArena.allocate<ControllerZone*>(zones.size());
+    Span<ControllerZone*> nonSpatialZones = frameArena.allocate<ControllerZone*>(zones.size());
+    size_t spatialCount = 0;
+    size_t nonSpatialCount = 0;
     
     // Separate zones into spatial and non-spatial
     for (auto* zone : zones)
@@ -228,47 +317,49 @@ void BaseEffect::StepEffect(std::vector<ControllerZone*> zones)
         // Check if this is a SpatialControllerZone
         if (dynamic_cast<SpatialControllerZone*>(zone))
         {
-            spatialZones.push_back(zone);
+            spatialZones[spatialCount++] = zone;
         }
         else
         {
-            nonSpatialZones.push_back(zone);
+            nonSpatialZones[nonSpatialCount++] = zone;
         }
     }
     
     // Process zones according to their type
-    processSpatialZones(spatialZones, time);
-    processNonSpatialZones(nonSpatialZones, time);
+    processSpatialZones(spatialZones.first(spatialCount), time);
+    processNonSpatialZones(nonSpatialZones.first(nonSpatialCount), time);
 }
 
-void BaseEffect::OnControllerZonesListChanged(std::vector<ControllerZone*> zones)
+void BaseEffect::OnControllerZonesListChanged(ConstSpan<ControllerZone*> zones)
 {
     // Default implementation does nothing, derived classes can override
     // This is called when the list of zones changes
 }
 
-void BaseEffect::processSpatialZones(std::vector<ControllerZone*> zones, float time)
+void BaseEffect::processSpatialZones(ConstSpan<ControllerZone*> zones, float time)
 {
-    // Process zones with spatial information
+    // Collect the zone positions and calculate all colors in one batch; zones
+    // answer distance/angle queries from this frame's field
+    frameBatch.clear();
     for (auto* zone : zones)
     {
-        SpatialControllerZone* spatialZone = dynamic_cast<SpatialControllerZone*>(zone);
-        if (!spatialZone) continue;
-        
-        // Get position and calculate color
-        const GridPosition& position = spatialZone->position;
-        RGBColor color = getColorForPosition(position, time);
-        
-        // Apply brightness
-        float brightnessValue = brightness / 100.0f;
-        color = applyBrightness(color, brightnessValue);
+        SpatialControllerZone* spatialZone = static_cast<SpatialControllerZone*>(zone);
+        spatialZone->field = frameField.get();
+        frameBatch.append(spatialZone->position);
+    }
+    evaluateFrameBatch(time);
+    
+    for (size_t i = 0; i < zones.size(); i++)
+    {
+        // Zones were sorted by StepEffect, so they are all spatial here
+        SpatialControllerZone* spatialZone = static_cast<SpatialControllerZone*>(zones[i]);
         
-        // Set color for all LEDs in the zone
-        spatialZone->setAllLEDs(color);
+        // Set color for all LEDs in the zone (brightness is already applied)
+        spatialZone->setAllLEDs(frameColors[i]);
     }
 }
 
-void BaseEffect::processNonSpatialZones(std::vector<ControllerZone*> zones, float time)
+void BaseEffect::processNonSpatialZones(ConstSpan<ControllerZone*> zones, float time)
 {
     // Default implementation for non-spatial zones - derived classes might override
     // For non-spatial zones, we'll use a simple time-based approach
@@ -276,20 +367,21 @@ void BaseEffect::processNonSpatialZones(std::vector<ControllerZone*> zones, floa
     int zoneCount = static_cast<int>(zones.size());
     if (zoneCount == 0) return;
     
+    // Create a virtual position per zone based on its index
+    // This creates a simple linear arrangement in the X axis
+    frameBatch.clear();
+    for (int i = 0; i < zoneCount; i++)
+    {
+        frameBatch.append(GridPosition(i, 0, 0));
+    }
+    
+    // Calculate colors using the same algorithm as spatial zones
+    evaluateFrameBatch(time);
+    
     for (int i = 0; i < zoneCount; i++)
     {
         ControllerZone* zone = zones[i];
-        
-        // Create a virtual position based on zone index
-        // This creates a simple linear arrangement in the X axis
-        GridPosition virtualPos(i, 0, 0);
-        
-        // Calculate color using the same algorithm as spatial zones
-        RGBColor color = getColorForPosition(virtualPos, time);
-        
-        // Apply brightness
-        float brightnessValue = brightness / 100.0f;
-        color = applyBrightness(color, brightnessValue);
+        RGBColor color = frameColors[i];
         
         // Apply to all LEDs in the zone
         unsigned int ledCount = zone->getLEDCount();
@@ -0,0 +1,111 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| ColorScale.cpp                                            |
+|                                                           |
+| Fixed-point brightness scaling for RGBColor values        |
+\*---------------------------------------------------------*/
+
+#include "effects/ColorScale.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHTSCAPE_SCALE_SSE2 1
+#endif
+
+namespace Lightscape {
+
+namespace {
+
+constexpr int BrightnessLevels = 101;
+
+struct BrightnessTables {
+    uint8_t table[BrightnessLevels][256];
+
+    BrightnessTables()
+    {
+        for (int level = 0; level < BrightnessLevels; level++) {
+            uint32_t factor = brightnessFactor(level);
+            for (uint32_t c = 0; c < 256; c++) {
+                table[level][c] = static_cast<uint8_t>((c * factor) >> 8);
+            }
+        }
+    }
+};
+
+// Red and blue share one multiply, green takes the other; no channel can
+// overflow into its neighbour because factor <= 256
+inline RGBColor scalePacked(uint32_t color, uint32_t factor)
+{
+    uint32_t rb = ((color & 0x00FF00FF) * factor >> 8) & 0x00FF00FF;
+    uint32_t g  = ((color & 0x0000FF00) * factor >> 8) & 0x0000FF00;
+    return rb | g;
+}
+
+} // namespace
+
+uint32_t brightnessFactor(int percent)
+{
+    percent = std::max(0, std::min(100, percent));
+    return static_cast<uint32_t>((percent * 256 + 50) / 100);
+}
+
+const uint8_t* brightnessTable(int percent)
+{
+    static const BrightnessTables tables;
+    return tables.table[std::max(0, std::min(100, percent))];
+}
+
+RGBColor scaleColor(RGBColor color, int percent)
+{
+    const uint8_t* table = brightnessTable(percent);
+    return ToRGBColor(table[RGBGetRValue(color)], table[RGBGetGValue(color)], table[RGBGetBValue(color)]);
+}
+
+void scaleColors(const RGBColor* src, RGBColor* dst, size_t count, int percent)
+{
+    const uint32_t factor = brightnessFactor(percent);
+
+    if (factor >= 256) {
+        if (src != dst) std::memmove(dst, src, count * sizeof(RGBColor));
+        return;
+    }
+    if (factor == 0) {
+        std::fill(dst, dst + count, RGBColor(0));
+        return;
+    }
+
+    size_t i = 0;
+
+#ifdef LIGHTSCAPE_SCALE_SSE2
+    // Four colors per register, widened to 16-bit lanes for the multiply
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i scale = _mm_set1_epi16(static_cast<short>(factor));
+    const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+
+    auto scale4 = [&](__m128i colors) {
+        __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(colors, zero), scale), 8);
+        __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(colors, zero), scale), 8);
+        return _mm_and_si128(_mm_packus_epi16(lo, hi), rgbMask);
+    };
+
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), scale4(a));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), scale4(b));
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), scale4(a));
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] = scalePacked(src[i], factor);
+    }
+}
+
+} // namespace Lightscape
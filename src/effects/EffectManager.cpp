@@ -11,6 +11,8 @@
 #include "effects/SpatialControllerZone.h"
 #include "devices/DeviceManager.h"
 #include "grid/SpatialGrid.h"
+#include "core/LoggingManager.h"
+#include <QMetaObject>
 #include <chrono>
 #include <thread>
 
@@ -23,14 +25,16 @@ EffectManager& EffectManager::getInstance()
 }
 
 EffectManager::EffectManager()
-    : _updateTimer(new QTimer(this))
 {
-    connect(_updateTimer, &QTimer::timeout, this, &EffectManager::updateEffect);
-    _frameTimer.start();
+    // The render thread always finds a snapshot, even before anything is configured
+    publishSnapshot();
 }
 
 EffectManager::~EffectManager()
 {
+    // The render thread must be gone before anything it references is destroyed
+    stopRenderThread();
+    
     // Stop all effects
     for (auto it = _runningEffects.begin(); it != _runningEffects.end(); ++it) {
         BaseEffect* effect = it.key();
@@ -56,6 +60,11 @@ void EffectManager::initialize(::DeviceManager* manager, ::SpatialGrid* grid)
 {
     _deviceManager = manager;
     _spatialGrid = grid;
+    _compositor.setDeviceManager(manager);
+    _compositor.setStatistics(&_statistics);
+    
+    // A slow controller must not stall the frame loop for the others
+    _compositor.setAsyncOutput(true);
 }
 
 bool EffectManager::startEffect(const QString& effectId)
@@ -75,15 +84,14 @@ bool EffectManager::startEffect(const QString& effectId)
     _activeEffect->initialize(_deviceManager, _spatialGrid);
     _activeEffect->start();
     
-    // Start update timer
-    _isRunning = true;
-    if (!_updateTimer->isActive()) {
-        _updateTimer->start(_updateInterval);
-    }
-    _frameTimer.restart();
-    
     // Add to running effects
+    _isRunning = true;
     _runningEffects[_activeEffect] = true;
+    _layerOrder.append(_activeEffect);
+    
+    // Hand the effect to the render thread
+    publishSnapshot();
+    startRenderThread();
     
     emit effectStarted(effectId);
     emit effectStarted(_activeEffect);
@@ -95,26 +103,22 @@ void EffectManager::stopEffect()
     // Legacy method that stops the current effect
     if (_activeEffect)
     {
-        if (!_updateTimer->isActive()) {
-            _updateTimer->stop();
-        }
         _activeEffect->stop();
         
-        // Clean up any effect thread
-        auto it = _effectThreads.find(_activeEffect);
-        if (it != _effectThreads.end())
-        {
-            std::thread* thread = it->second;
-            if (thread && thread->joinable())
-            {
-                thread->join();
-                delete thread;
-            }
-            _effectThreads.erase(it);
-        }
-        
         // Remove from running effects
         _runningEffects.remove(_activeEffect);
+        _effectDevices.remove(_activeEffect);
+        _layerOrder.removeAll(_activeEffect);
+        _layerSettings.remove(_activeEffect);
+        _previews.remove(_activeEffect);
+        
+        // Detach the effect from the render thread before it is deleted
+        publishSnapshot();
+        synchronizeRenderThread();
+        
+        if (_runningEffects.isEmpty()) {
+            stopRenderThread();
+        }
         
         emit effectStopped();
         emit effectStopped(_activeEffect);
@@ -146,14 +150,10 @@ bool EffectManager::startEffect(const QString& effectId, BaseEffect* existingEff
     // Start the effect
     existingEffect->start();
     
-    // Start update timer if not already running
-    if (!_updateTimer->isActive()) {
-        _updateTimer->start(_updateInterval);
-        printf("[Lightscape][EffectManager] Started update timer\n");
-    }
-    
     // Add to running effects
     _runningEffects[existingEffect] = true;
+    _layerOrder.removeAll(existingEffect);
+    _layerOrder.append(existingEffect);
     
     // Legacy: update current effect if none is set
     if (!_activeEffect) {
@@ -162,15 +162,12 @@ bool EffectManager::startEffect(const QString& effectId, BaseEffect* existingEff
         _isRunning = true;
     }
     
-    // Get the device info for this effect 
-    QList<DeviceInfo> deviceInfo = _effectDevices.value(existingEffect, QList<DeviceInfo>());
-    printf("[Lightscape][EffectManager] Effect has %d devices\n", deviceInfo.size());
+    printf("[Lightscape][EffectManager] Effect has %d devices\n", 
+           _effectDevices.value(existingEffect).size());
     
-    // Force an immediate update
-    if (!deviceInfo.isEmpty()) {
-        printf("[Lightscape][EffectManager] Applying immediate colors on effect start\n");
-        existingEffect->applyToDevices(deviceInfo);
-    }
+    // The render thread picks the effect up on its next frame
+    publishSnapshot();
+    startRenderThread();
     
     emit effectStarted(effectId);
     emit effectStarted(existingEffect);
@@ -196,8 +193,18 @@ void EffectManager::stopEffect(BaseEffect* effect)
     
     // Remove from running effects
     _runningEffects[effect] = false;
+    _layerOrder.removeAll(effect);
     
-    // Check if we should stop the timer
+    // Legacy: clear current effect if it's this one
+    bool wasActiveEffect = (_activeEffect == effect);
+    if (wasActiveEffect) {
+        _activeEffect = nullptr;
+        _currentEffectId = "";
+        _isRunning = false;
+    }
+    publishSnapshot();
+    
+    // Check if we should stop the render thread
     bool anyRunning = false;
     for (auto it = _runningEffects.begin(); it != _runningEffects.end(); ++it) {
         if (it.value()) {
@@ -206,19 +213,14 @@ void EffectManager::stopEffect(BaseEffect* effect)
         }
     }
     
-    if (!anyRunning) {
-        _updateTimer->stop();
-    }
-    
-    // Legacy: clear current effect if it's this one
-    if (_activeEffect == effect) {
-        _activeEffect = nullptr;
-        _currentEffectId = "";
-        _isRunning = false;
+    if (anyRunning) {
+        synchronizeRenderThread();
+    } else {
+        stopRenderThread();
     }
     
     emit effectStopped(effect);
-    if (_activeEffect == effect) {
+    if (wasActiveEffect) {
         emit effectStopped();
     }
 }
@@ -231,14 +233,39 @@ bool EffectManager::isEffectRunning(BaseEffect* effect) const
 QList<BaseEffect*> EffectManager::getRunningEffects() const
 {
     QList<BaseEffect*> running;
-    for (auto it = _runningEffects.begin(); it != _runningEffects.end(); ++it) {
-        if (it.value()) {
-            running.append(it.key());
+    for (BaseEffect* effect : _layerOrder) {
+        if (_runningEffects.value(effect, false)) {
+            running.append(effect);
         }
     }
     return running;
 }
 
+void EffectManager::setEffectLayer(BaseEffect* effect, const LayerSettings& settings)
+{
+    if (!effect) return;
+    
+    _layerSettings[effect] = settings;
+    publishSnapshot();
+}
+
+LayerSettings EffectManager::getEffectLayer(BaseEffect* effect) const
+{
+    return _layerSettings.value(effect, LayerSettings());
+}
+
+void EffectManager::moveEffectLayer(BaseEffect* effect, int position)
+{
+    int current = _layerOrder.indexOf(effect);
+    if (current < 0) return;
+    
+    position = qBound(0, position, _layerOrder.size() - 1);
+    if (position == current) return;
+    
+    _layerOrder.move(current, position);
+    publishSnapshot();
+}
+
 void EffectManager::setActiveDevices(const QList<DeviceInfo>& devices)
 {
     _activeDevices = devices;
@@ -247,6 +274,8 @@ void EffectManager::setActiveDevices(const QList<DeviceInfo>& devices)
     // Legacy: if current effect is set, update its devices
     if (_activeEffect) {
         _effectDevices[_activeEffect] = devices;
+        bindDevices();
+        publishSnapshot();
     }
 }
 
@@ -260,18 +289,15 @@ void EffectManager::setActiveDevicesForEffect(BaseEffect* effect, const QList<De
     
     _effectDevices[effect] = devices;
     
+    // The render thread applies the new devices on its next frame
+    bindDevices();
+    publishSnapshot();
+    
     // Update active devices for the current effect
     if (_activeEffect == effect) {
         _activeDevices = devices;
         updateZonesFromDevices();
     }
-    
-    // If the effect is running, update the device colors immediately
-    if (isEffectRunning(effect)) {
-        printf("[Lightscape][EffectManager] Effect is running, applying colors immediately\n");
-        // Force an update by calling applyToDevices directly
-        effect->applyToDevices(devices);
-    }
 }
 
 QList<DeviceInfo> EffectManager::getActiveDevicesForEffect(BaseEffect* effect) const
@@ -282,6 +308,7 @@ QList<DeviceInfo> EffectManager::getActiveDevicesForEffect(BaseEffect* effect) c
 void EffectManager::setActiveZones(const std::vector<ControllerZone*>& zones)
 {
     _activeZones = zones;
+    publishSnapshot();
 }
 
 std::vector<ControllerZone*> EffectManager::getActiveZones() const
@@ -301,12 +328,9 @@ std::vector<SpatialControllerZone*> EffectManager::getSpatialZones() const
 
 void EffectManager::updateZonesFromDevices()
 {
-    // Clear existing zones
-    for (auto* zone : _spatialZones)
-    {
-        delete zone;
-    }
-    _spatialZones.clear();
+    // Keep the old zones alive until the render thread has let go of them
+    std::vector<SpatialControllerZone*> oldZones;
+    oldZones.swap(_spatialZones);
     
     // Create new spatial zones from active devices
     for (const DeviceInfo& device : _activeDevices)
@@ -316,16 +340,21 @@ void EffectManager::updateZonesFromDevices()
             SpatialControllerZone* zone = SpatialControllerZone::fromDeviceInfo(device, _deviceManager);
             if (zone)
             {
+                zone->compositor = &_compositor;
                 _spatialZones.push_back(zone);
             }
         }
     }
     
     // Update the active zones list to include spatial zones
-    _activeZones.clear();
-    for (auto* zone : _spatialZones)
+    std::vector<ControllerZone*> zones(_spatialZones.begin(), _spatialZones.end());
+    setActiveZones(zones);
+    
+    // Once the render thread has switched over, the old zones can go
+    synchronizeRenderThread();
+    for (auto* zone : oldZones)
     {
-        _activeZones.push_back(zone);
+        delete zone;
     }
 }
 
@@ -337,6 +366,8 @@ void EffectManager::setPreviewEnabled(bool enabled)
 void EffectManager::setPreviewRenderer(PreviewRenderer* renderer)
 {
     _previewRenderer = renderer;
+    publishSnapshot();
+    synchronizeRenderThread();
 }
 
 void EffectManager::addPreview(BaseEffect* effect, ControllerZone* preview)
@@ -344,23 +375,38 @@ void EffectManager::addPreview(BaseEffect* effect, ControllerZone* preview)
     if (effect && preview)
     {
         _previews[effect] = preview;
+        publishSnapshot();
     }
 }
 
 void EffectManager::removePreview(BaseEffect* effect)
 {
-    if (_previews.contains(effect))
-    {
-        _previews.remove(effect);
+    // Wait for the render thread so the caller may delete the preview zone right away
+    _previews.remove(effect);
+    publishSnapshot();
+    synchronizeRenderThread();
+}
+
+void EffectManager::resetFrameStatistics()
+{
+    _statistics.reset();
+    _scheduler.resetStatistics();
+    
+    if (_deviceManager) {
+        _deviceManager->ResetOutputStatistics();
     }
 }
 
+std::vector<DeviceOutputPool::ControllerStatistics> EffectManager::getOutputStatistics() const
+{
+    if (!_deviceManager) return {};
+    return _deviceManager->GetOutputStatistics();
+}
+
 void EffectManager::setReducedFps(bool reduced)
 {
+    // Picked up by the render thread at the start of its next frame
     _updateInterval = reduced ? 100 : 33; // 10 FPS or 30 FPS
-    if (_updateTimer->isActive()) {
-        _updateTimer->setInterval(_updateInterval);
-    }
 }
 
 QJsonObject EffectManager::saveProfile() const
@@ -384,6 +430,13 @@ QJsonObject EffectManager::saveProfile() const
         // Save effect settings
         effectObject["settings"] = effect->saveSettings();
         
+        // Save layer blending, the array order is the stacking order
+        LayerSettings layer = getEffectLayer(effect);
+        QJsonObject layerObject;
+        layerObject["blend"] = blendModeToString(layer.mode);
+        layerObject["opacity"] = layer.opacity;
+        effectObject["layer"] = layerObject;
+        
         // Save associated devices
         QJsonArray devicesArray;
         QList<DeviceInfo> devices = _effectDevices.value(effect, QList<DeviceInfo>());
@@ -439,6 +492,7 @@ bool EffectManager::loadProfile(const QJsonObject& profile)
     
     // Clear effect devices
     _effectDevices.clear();
+    publishSnapshot();
     
     // Load effects
     QJsonArray effectsArray = profile["effects"].toArray();
@@ -498,8 +552,18 @@ bool EffectManager::loadProfile(const QJsonObject& profile)
             }
         }
         
-        // Store devices
+        // Store devices, pinned to the controllers they refer to now
         _effectDevices[effect] = devices;
+        bindDevices();
+        
+        // Layer blending, older profiles default to normal at full opacity
+        if (effectObject.contains("layer")) {
+            QJsonObject layerObject = effectObject["layer"].toObject();
+            LayerSettings layer;
+            layer.mode = blendModeFromString(layerObject["blend"].toString());
+            layer.opacity = layerObject["opacity"].toInt(100);
+            setEffectLayer(effect, layer);
+        }
         
         // Start effect if needed
         bool running = effectObject["running"].toBool(true);
@@ -511,82 +575,194 @@ bool EffectManager::loadProfile(const QJsonObject& profile)
     return true;
 }
 
-void EffectManager::updateEffect()
+void EffectManager::bindDevices()
 {
-    // Calculate delta time in seconds
-    float deltaTime = _frameTimer.elapsed() / 1000.0f;
-    _frameTimer.restart();
+    // The device indices refer to the controller list as it is now. Pin
+    // them, so a rescan before the next frame can't redirect them.
+    if (!_deviceManager) return;
     
-    // Create local copies to minimize lock duration
-    QMap<BaseEffect*, bool> runningEffectsCopy;
-    QMap<BaseEffect*, QList<DeviceInfo>> effectDevicesCopy;
-    std::vector<ControllerZone*> activeZonesCopy;
-    BaseEffect* activeEffectCopy = nullptr;
+    _deviceHandles = std::make_shared<const std::vector<DeviceHandle>>(_deviceManager->GetDeviceHandles());
+    _deviceBinding++;
+}
+
+void EffectManager::publishSnapshot()
+{
+    // UI thread. Rebuilt from scratch: a handful of effects and their device
+    // lists, copied here so the render thread never has to.
+    std::shared_ptr<RenderSnapshot> snapshot = std::make_shared<RenderSnapshot>();
+    snapshot->version = ++_snapshotVersion;
     
-    {
-        std::lock_guard<std::mutex> lock(_mutex);
-        runningEffectsCopy = _runningEffects;
-        effectDevicesCopy = _effectDevices;
-        activeZonesCopy = _activeZones;
-        activeEffectCopy = _activeEffect;
+    for (BaseEffect* effect : _layerOrder) {
+        if (!effect || !_runningEffects.value(effect, false)) continue;
+        
+        RenderSnapshot::Layer layer;
+        layer.effect = effect;
+        layer.settings = _layerSettings.value(effect, LayerSettings());
+        const QList<DeviceInfo> devices = _effectDevices.value(effect);
+        layer.devices.assign(devices.begin(), devices.end());
+        snapshot->layers.push_back(std::move(layer));
+    }
+    
+    snapshot->activeEffect = _runningEffects.value(_activeEffect, false) ? _activeEffect : nullptr;
+    snapshot->activeZones = _activeZones;
+    snapshot->previewRenderer = _previewRenderer;
+    for (auto it = _previews.constBegin(); it != _previews.constEnd(); ++it) {
+        snapshot->previews.push_back({it.key(), it.value()});
+    }
+    
+    snapshot->deviceBinding = _deviceBinding;
+    snapshot->deviceHandles = _deviceHandles;
+    
+    std::atomic_store(&_publishedSnapshot, std::shared_ptr<const RenderSnapshot>(std::move(snapshot)));
+    _publishedVersion.store(_snapshotVersion, std::memory_order_release);
+}
+
+void EffectManager::acquireSnapshot()
+{
+    // Caller holds _frameMutex. The common case, nothing changed, is one atomic load.
+    quint64 version = _publishedVersion.load(std::memory_order_acquire);
+    if (_renderSnapshot && _renderSnapshot->version == version) return;
+    
+    std::shared_ptr<const RenderSnapshot> snapshot = std::atomic_load(&_publishedSnapshot);
+    if (snapshot->deviceBinding != _boundDeviceBinding) {
+        if (snapshot->deviceHandles) {
+            _compositor.bindDevices(*snapshot->deviceHandles);
+        }
+        _boundDeviceBinding = snapshot->deviceBinding;
+    }
+    
+    // The previous snapshot is released here, on config changes only
+    _renderSnapshot = std::move(snapshot);
+}
+
+void EffectManager::synchronizeRenderThread()
+{
+    // Waits for any frame in progress, then takes up the latest snapshot directly.
+    // After this returns the render thread no longer references anything removed.
+    std::lock_guard<std::mutex> lock(_frameMutex);
+    acquireSnapshot();
+}
+
+void EffectManager::startRenderThread()
+{
+    if (_renderThreadRunning) return;
+    
+    if (_renderThread.joinable()) {
+        _renderThread.join();
     }
     
-    // Update all running effects
-    for (auto it = runningEffectsCopy.begin(); it != runningEffectsCopy.end(); ++it) {
-        if (!it.value()) continue; // Skip effects that aren't running
+    _renderThreadRunning = true;
+    _renderThread = std::thread(&EffectManager::renderThreadFunction, this);
+    printf("[Lightscape][EffectManager] Started render thread\n");
+}
+
+void EffectManager::stopRenderThread()
+{
+    _renderThreadRunning = false;
+    
+    if (_renderThread.joinable()) {
+        _renderThread.join();
+        printf("[Lightscape][EffectManager] Stopped render thread\n");
+    }
+    
+    // Let the output workers finish the last frame before anyone else writes
+    if (_deviceManager) {
+        _deviceManager->FlushOutput();
+    }
+    
+    // Nothing renders anymore, so keep the render state in step with the UI
+    synchronizeRenderThread();
+}
+
+void EffectManager::renderThreadFunction()
+{
+    int interval = _updateInterval;
+    _scheduler.setInterval(std::chrono::milliseconds(interval));
+    
+    while (_renderThreadRunning)
+    {
+        // Sleep until the next absolute deadline
+        float deltaTime = _scheduler.waitForNextFrame();
+        if (!_renderThreadRunning) break;
         
-        BaseEffect* effect = it.key();
-        if (!effect) continue;
+        // Apply a frame rate change requested by the UI
+        int requestedInterval = _updateInterval;
+        if (requestedInterval != interval) {
+            interval = requestedInterval;
+            _scheduler.setInterval(std::chrono::milliseconds(interval));
+        }
+        
+        std::lock_guard<std::mutex> lock(_frameMutex);
+        acquireSnapshot();
+        
+        _statistics.beginFrame(_scheduler.getInterval());
+        renderFrame(deltaTime);
+        _statistics.endFrame(_scheduler.getDroppedFrameCount());
+    }
+}
+
+void EffectManager::renderFrame(float deltaTime)
+{
+    // Runs on the render thread with _frameMutex held
+    const RenderSnapshot& snapshot = *_renderSnapshot;
+    
+    // Start a new output frame; effects write into the compositor, not the devices
+    _compositor.beginFrame();
+    
+    // Update all running effects, each one into its own layer (bottom first)
+    for (const RenderSnapshot::Layer& layer : snapshot.layers) {
+        BaseEffect* effect = layer.effect;
+        _compositor.beginLayer(layer.settings);
         
         try {
             // Update the effect
+            FrameStatistics::Clock::time_point stageStart = FrameStatistics::Clock::now();
             effect->update(deltaTime);
-            
-            // Get devices for this effect
-            QList<DeviceInfo> effectDevices = effectDevicesCopy.value(effect, QList<DeviceInfo>());
+            FrameStatistics::Clock::time_point updateEnd = FrameStatistics::Clock::now();
+            _statistics.addStageTime(FrameStage::EffectUpdate, updateEnd - stageStart);
             
             // Apply effect if it has devices
-            if (!effectDevices.isEmpty()) {
-                printf("[Lightscape][EffectManager] Applying effect to %d devices\n", effectDevices.size());
-                effect->applyToDevices(effectDevices);
+            if (!layer.devices.empty()) {
+                LOG_TRACE("[Lightscape][EffectManager] Applying effect to %d devices", static_cast<int>(layer.devices.size()));
+                effect->renderToCompositor(layer.devices, _compositor);
             } else {
-                printf("[Lightscape][EffectManager] WARNING: Effect has NO devices assigned!\n");
+                LOG_TRACE("[Lightscape][EffectManager] Effect has no devices assigned");
             }
             
             // Legacy: also use zones for the current effect
-            if (effect == activeEffectCopy && !activeZonesCopy.empty()) {
-                // Create a copy to avoid modifying the vector during iteration
-                std::vector<ControllerZone*> zonesCopy = activeZonesCopy;
-                effect->StepEffect(zonesCopy);
+            if (effect == snapshot.activeEffect && !snapshot.activeZones.empty()) {
+                effect->StepEffect(snapshot.activeZones);
             }
+            _statistics.addStageTime(FrameStage::ColorEvaluation, FrameStatistics::Clock::now() - updateEnd);
         } catch (const std::exception& e) {
-            printf("[Lightscape][EffectManager] Exception in effect update: %s\n", e.what());
+            LOG_THROTTLED(LogLevel::Error, "[Lightscape][EffectManager] Exception in effect update: %s", e.what());
         } catch (...) {
-            printf("[Lightscape][EffectManager] Unknown exception in effect update\n");
+            LOG_THROTTLED(LogLevel::Error, "[Lightscape][EffectManager] Unknown exception in effect update");
         }
+        
+        ScopedStageTimer compositingTimer(_statistics, FrameStage::Compositing);
+        _compositor.endLayer();
     }
     
-    // Handle preview (with separate lock scope)
+    // Push the composed frame: one update per touched controller
+    {
+        ScopedStageTimer flushTimer(_statistics, FrameStage::DeviceFlush);
+        _compositor.flush();
+    }
+    
+    // Handle preview
     if (_previewEnabled) {
-        // Update preview renderer if available
-        PreviewRenderer* previewRendererCopy = nullptr;
-        QMap<BaseEffect*, ControllerZone*> previewsCopy;
+        ScopedStageTimer previewTimer(_statistics, FrameStage::Preview);
         
-        {
-            std::lock_guard<std::mutex> lock(_mutex);
-            previewRendererCopy = _previewRenderer;
-            previewsCopy = _previews;
-        }
-        
-        // Update preview renderer
-        if (previewRendererCopy) {
-            previewRendererCopy->update();
+        // Repaint the preview widget on the GUI thread
+        if (snapshot.previewRenderer) {
+            QMetaObject::invokeMethod(snapshot.previewRenderer, "update", Qt::QueuedConnection);
         }
         
         // Process previews for effects
-        for (auto it = previewsCopy.begin(); it != previewsCopy.end(); ++it) {
-            BaseEffect* effect = it.key();
-            ControllerZone* previewZone = it.value();
+        for (const RenderSnapshot::Preview& preview : snapshot.previews) {
+            BaseEffect* effect = preview.effect;
+            ControllerZone* previewZone = preview.zone;
             
             if (effect && previewZone) {
                 try {
@@ -594,73 +770,28 @@ void EffectManager::updateEffect()
                     effect->update(deltaTime);
                     
                     // Apply to just this one zone
-                    std::vector<ControllerZone*> previewZones = {previewZone};
-                    effect->StepEffect(previewZones);
+                    effect->StepEffect(ConstSpan<ControllerZone*>(&previewZone, 1));
                 } catch (const std::exception& e) {
-                    printf("[Lightscape][EffectManager] Exception in preview update: %s\n", e.what());
+                    LOG_THROTTLED(LogLevel::Error, "[Lightscape][EffectManager] Exception in preview update: %s", e.what());
                 } catch (...) {
-                    printf("[Lightscape][EffectManager] Unknown exception in preview update\n");
+                    LOG_THROTTLED(LogLevel::Error, "[Lightscape][EffectManager] Unknown exception in preview update");
                 }
             }
         }
         
+        // Queued to receivers on the GUI thread
         emit previewUpdated();
     }
 }
 
-void EffectManager::effectThreadFunction(BaseEffect* effect)
-{
-    if (!effect) return;
-    
-    std::vector<ControllerZone*> effectZones;
-    
-    // Get a copy of the zones this thread will work on
-    {
-        std::lock_guard<std::mutex> lock(_mutex);
-        effectZones = _activeZones;
-    }
-    
-    // Initial callback to inform the effect of available zones
-    effect->OnControllerZonesListChanged(effectZones);
-    
-    // Check if the effect is still running
-    bool isRunning = _runningEffects.contains(effect) && _runningEffects[effect];
-    
-    // Main effect loop
-    while (isRunning)
-    {
-        // Calculate the frame delay based on FPS
-        unsigned int fps = effect->getFPS();
-        if (fps == 0) fps = 60; // Default to 60 FPS if not specified
-        
-        auto frameDelay = std::chrono::milliseconds(1000 / fps);
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
-        // Process the effect
-        {
-            std::lock_guard<std::mutex> lock(_mutex);
-            effect->StepEffect(effectZones);
-        }
-        
-        // Calculate time spent and sleep for the remainder of the frame time
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-        
-        if (elapsedTime < frameDelay)
-        {
-            std::this_thread::sleep_for(frameDelay - elapsedTime);
-        }
-        
-        // Check if effect is still running
-        isRunning = _runningEffects.contains(effect) && _runningEffects[effect];
-    }
-}
-
 void EffectManager::updateDevicePositions()
 {
     // Sync spatial zones with device positions from the grid
     if (!_spatialGrid) return;
     
+    // Zones are read by the render thread, so update them between frames
+    std::lock_guard<std::mutex> lock(_frameMutex);
+    
     for (auto* zone : _spatialZones)
     {
         // Look up the current position in the grid
@@ -668,8 +799,10 @@ void EffectManager::updateDevicePositions()
         {
             DeviceInfo deviceInfo;
             deviceInfo.index = zone->deviceIndex;
+            deviceInfo.type = DeviceType::RGB;
             deviceInfo.zoneIndex = zone->zoneIndex;
             
+            // Hash lookup in the grid's reverse index
             std::optional<GridPosition> pos = _spatialGrid->GetDevicePosition(deviceInfo);
             if (pos.has_value())
             {
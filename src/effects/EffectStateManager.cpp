@@ -93,13 +93,9 @@ void EffectStateManager::setEffectRunning(BaseEffect* effect, bool running)
             printf("[Lightscape][StateManager] WARNING: Failed to start effect: %s\n", 
                    effect->GetStaticInfo().name.toStdString().c_str());
         } else {
-            // Force an immediate color update after starting
-            if (_effectDevices.contains(effect)) {
-                QList<DeviceInfo> devices = _effectDevices[effect];
-                printf("[Lightscape][StateManager] Forcing immediate color update for %d devices\n", devices.size());
-                effect->applyToDevices(devices);
-                success = true;
-            }
+            // The render thread applies colors on its next frame; rendering here
+            // as well would race with it on the effect's frame buffers
+            success = _effectDevices.contains(effect);
         }
     } else {
         // Stop effect
@@ -72,6 +72,8 @@ void EffectWidget::setupConnections()
     if (spatialGrid) {
         connect(spatialGrid, &SpatialGrid::assignmentsChanged,
                 this, &EffectWidget::updateDeviceList);
+        connect(spatialGrid, &SpatialGrid::assignmentsCommitted,
+                this, &EffectWidget::updateDeviceList);
     }
 }
 
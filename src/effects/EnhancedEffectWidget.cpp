@@ -12,6 +12,7 @@
 #include "effects/EffectRegistry.h"
 #include "effects/EffectSelectorDialog.h"
 #include "effects/EffectStateManager.h"
+#include "core/LayoutFile.h"
 
 #include <QResizeEvent>
 #include <QFileDialog>
@@ -479,14 +480,15 @@ void EnhancedEffectWidget::onSaveProfileClicked()
             this,
             "Save Profile",
             "",
-            "Lightscape Profiles (*.json)"
+            "Lightscape Profiles (*.lscp);;JSON Profiles (*.json)"
         );
         
         if (filename.isEmpty()) return;
         
-        // Add .json extension if not present
-        if (!filename.endsWith(".json")) {
-            filename += ".json";
+        // Binary unless JSON was asked for explicitly
+        bool saveAsJson = filename.endsWith(".json");
+        if (!saveAsJson && !filename.endsWith(".lscp")) {
+            filename += ".lscp";
         }
         
         // Create profile JSON
@@ -535,8 +537,13 @@ void EnhancedEffectWidget::onSaveProfileClicked()
         // Write to file
         QFile file(filename);
         if (file.open(QIODevice::WriteOnly)) {
-            QJsonDocument doc(profileObject);
-            file.write(doc.toJson());
+            if (saveAsJson) {
+                file.write(QJsonDocument(profileObject).toJson());
+            } else {
+                LayoutFile layout;
+                layout.setSection(LayoutFile::EffectsSection, QCborValue::fromJsonValue(profileObject));
+                file.write(layout.toCbor());
+            }
             file.close();
             
             QMessageBox::information(this, "Save Profile", "Profile saved successfully.");
@@ -565,7 +572,7 @@ void EnhancedEffectWidget::onLoadProfileClicked()
             this,
             "Load Profile",
             "",
-            "Lightscape Profiles (*.json)"
+            "Lightscape Profiles (*.lscp *.json)"
         );
         
         if (filename.isEmpty()) return;
@@ -580,17 +587,30 @@ void EnhancedEffectWidget::onLoadProfileClicked()
         QByteArray data = file.readAll();
         file.close();
         
-        // Parse JSON
-        QJsonParseError error;
-        QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+        QJsonObject profileObject;
         
-        if (error.error != QJsonParseError::NoError) {
-            QMessageBox::warning(this, "Load Profile", "Failed to parse profile: " + error.errorString());
-            return;
+        if (LayoutFile::isLayoutData(data)) {
+            // Binary profile: only the effects section is decoded
+            QString errorString;
+            std::optional<LayoutFile> layout = LayoutFile::fromCbor(data, &errorString);
+            if (!layout) {
+                QMessageBox::warning(this, "Load Profile", "Failed to parse profile: " + errorString);
+                return;
+            }
+            profileObject = layout->section(LayoutFile::EffectsSection).toJsonValue().toObject();
+        } else {
+            // Parse JSON
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+            
+            if (error.error != QJsonParseError::NoError) {
+                QMessageBox::warning(this, "Load Profile", "Failed to parse profile: " + error.errorString());
+                return;
+            }
+            
+            profileObject = doc.object();
         }
         
-        QJsonObject profileObject = doc.object();
-        
         // Check version
         if (!profileObject.contains("version") || !profileObject.contains("effects")) {
             QMessageBox::warning(this, "Load Profile", "Invalid profile format.");
@@ -880,24 +900,9 @@ void EnhancedEffectWidget::onEffectStartStopChanged(BaseEffect* effect, bool run
            effect->GetStaticInfo().name.toStdString().c_str(),
            running ? "RUNNING" : "STOPPED");
     
-    // Let the state manager handle everything
+    // Let the state manager handle everything. The render thread draws the
+    // first frame, rendering here would race it on the effect's frame state.
     EffectStateManager::getInstance().setEffectRunning(effect, running);
-    
-    // Force an effect update if the effect is now running
-    if (running) {
-        // Wait a short time to let the effect initialize
-        QTimer::singleShot(100, [effect]() {
-            if (effect->getEnabled()) {
-                printf("[Lightscape][EnhancedEffectWidget] Forcing initial effect update\n");
-                // Get devices for this effect from state manager
-                auto& stateManager = EffectStateManager::getInstance();
-                QList<DeviceInfo> devices = stateManager.getDevicesForEffect(effect);
-                if (!devices.isEmpty()) {
-                    effect->applyToDevices(devices);
-                }
-            }
-        });
-    }
 }
 
 void EnhancedEffectWidget::onEffectRenamed(BaseEffect* effect, const QString& newName)
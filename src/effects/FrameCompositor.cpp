@@ -0,0 +1,337 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameCompositor.cpp                                       |
+|                                                           |
+| Per-controller frame buffer for effect output             |
+\*---------------------------------------------------------*/
+
+#include "effects/FrameCompositor.h"
+#include "effects/FrameStatistics.h"
+#include "devices/DeviceManager.h"
+#include <algorithm>
+
+namespace Lightscape {
+
+FrameCompositor::FrameCompositor(::DeviceManager* deviceManager)
+    : _deviceManager(deviceManager)
+{
+}
+
+void FrameCompositor::setDeviceManager(::DeviceManager* deviceManager)
+{
+    if (_deviceManager != deviceManager) {
+        _deviceManager = deviceManager;
+        _buffers.clear();
+        _baseColors.clear();
+        _baseGeneration = 0;
+        _devices.clear();
+        _devicesBound = false;
+        _devicesGeneration = 0;
+    }
+}
+
+void FrameCompositor::bindDevices(const std::vector<DeviceHandle>& devices)
+{
+    _devices = devices;
+    _devicesBound = true;
+    _devicesGeneration = devices.empty() ? 0 : devices.front().generation;
+    _buffers.clear();
+}
+
+void FrameCompositor::refreshDevices()
+{
+    if (!_deviceManager) return;
+
+    quint64 generation = _deviceManager->RefreshControllers();
+    if (generation != _baseGeneration) rebindBaseColors(generation);
+    if (generation == _devicesGeneration) return;
+    _devicesGeneration = generation;
+
+    if (_devicesBound) {
+        for (DeviceHandle& device : _devices) {
+            _deviceManager->RebindDevice(device);
+        }
+    } else {
+        _devices = _deviceManager->GetDeviceHandles();
+    }
+
+    // Buffers were sized for the old controllers
+    _buffers.clear();
+}
+
+void FrameCompositor::rebindBaseColors(quint64 generation)
+{
+    // Carry the bases of controllers that are still there to their new handles;
+    // re-seeding them would capture frames the compositor wrote itself. A new
+    // controller allocated at a freed address doesn't match the saved name,
+    // location and LED count, so it takes a fresh snapshot instead.
+    const std::vector<DeviceHandle> current = _deviceManager->GetDeviceHandles();
+    _baseGeneration = generation;
+
+    std::map<int, BaseColors> rebound;
+    for (auto& entry : _baseColors) {
+        BaseColors& base = entry.second;
+        for (const DeviceHandle& device : current) {
+            if (device.controller == base.device.controller && device.ledCount == base.device.ledCount &&
+                device.controller->name == base.name && device.controller->location == base.location) {
+                base.device = device;
+                rebound[device.index] = std::move(base);
+                break;
+            }
+        }
+    }
+    _baseColors.swap(rebound);
+}
+
+bool FrameCompositor::loadBaseColors(const DeviceHandle& device, BaseColors& base)
+{
+    if (!_deviceManager->GetDeviceColors(device, base.colors)) return false;
+
+    base.device = device;
+    base.name = device.controller->name;
+    base.location = device.controller->location;
+    base.written.assign(base.colors.size(), 0);
+    return true;
+}
+
+void FrameCompositor::markWrittenColors(const ControllerBuffer& buffer)
+{
+    auto found = _baseColors.find(buffer.device.index);
+    if (found == _baseColors.end()) return;
+
+    BaseColors& base = found->second;
+    size_t count = std::min(base.colors.size(), buffer.colors.size());
+    for (size_t i = 0; i < count; i++) {
+        base.written[i] |= static_cast<uint8_t>(buffer.colors[i] != base.colors[i]);
+    }
+}
+
+void FrameCompositor::beginFrame()
+{
+    // Once per frame: a pointer and count comparison unless the controllers changed
+    refreshDevices();
+
+    // Keep the buffers allocated between frames, only reset the touched flags
+    for (auto it = _buffers.begin(); it != _buffers.end(); ++it) {
+        it.value().touched = false;
+        it.value().layerTouched = false;
+    }
+    _inLayer = false;
+}
+
+int FrameCompositor::flush()
+{
+    if (!_deviceManager) return 0;
+
+    int flushed = 0;
+    int skipped = 0;
+    for (auto it = _buffers.begin(); it != _buffers.end(); ++it) {
+        ControllerBuffer& buffer = it.value();
+        if (!buffer.touched) continue;
+        buffer.touched = false;
+        markWrittenColors(buffer);
+
+        // The worker does the delta check and the bus transfer, this thread never waits on it
+        if (_asyncOutput) {
+            _deviceManager->SubmitDeviceColors(buffer.device, buffer.colors);
+            flushed++;
+            continue;
+        }
+
+        // One UpdateLEDs per controller, regardless of how many LEDs were written,
+        // and none at all when the frame is identical to the last one sent
+        bool unchanged = false;
+        FrameStatistics::Clock::time_point start;
+        if (_statistics) start = FrameStatistics::Clock::now();
+
+        bool applied = _deviceManager->ApplyDeviceColors(buffer.device, buffer.colors, &unchanged);
+
+        if (_statistics && !unchanged) {
+            _statistics->addControllerFlushTime(buffer.device.index, FrameStatistics::Clock::now() - start);
+        }
+
+        if (applied) {
+            if (unchanged) {
+                skipped++;
+            } else {
+                flushed++;
+            }
+        }
+    }
+
+    // The workers time the bus transfers; report the ones finished since last frame
+    if (_asyncOutput && _statistics) {
+        _writeTimes.clear();
+        _deviceManager->TakeOutputWriteTimes(_writeTimes);
+        for (const DeviceOutputPool::WriteTime& write : _writeTimes) {
+            _statistics->addControllerFlushTime(write.deviceIndex, write.elapsed);
+        }
+    }
+
+    _lastFrameSent.store(flushed, std::memory_order_relaxed);
+    _lastFrameSkipped.store(skipped, std::memory_order_relaxed);
+    return flushed;
+}
+
+void FrameCompositor::clear()
+{
+    _buffers.clear();
+    _baseColors.clear();
+    _baseGeneration = 0;
+    _inLayer = false;
+}
+
+void FrameCompositor::beginLayer(const LayerSettings& settings)
+{
+    if (_inLayer) endLayer();
+
+    _layerSettings = settings;
+    _inLayer = true;
+}
+
+void FrameCompositor::endLayer()
+{
+    if (!_inLayer) return;
+    _inLayer = false;
+
+    uint8_t opacity = static_cast<uint8_t>(std::max(0, std::min(100, _layerSettings.opacity)) * 255 / 100);
+
+    // Merge every controller this layer wrote into the frame below it
+    for (auto it = _buffers.begin(); it != _buffers.end(); ++it) {
+        ControllerBuffer& buffer = it.value();
+        if (!buffer.layerTouched) continue;
+
+        blendLayer(_layerSettings.mode, opacity, buffer.layerColors.data(), buffer.layerMask.data(),
+                   buffer.colors.data(), buffer.colors.size());
+        buffer.layerTouched = false;
+    }
+}
+
+bool FrameCompositor::setLED(int deviceIndex, int ledIndex, RGBColor color)
+{
+    size_t size = 0;
+    uint8_t* mask = nullptr;
+    RGBColor* target = acquireTarget(deviceIndex, size, mask);
+    if (!target) return false;
+
+    if (ledIndex < 0 || static_cast<size_t>(ledIndex) >= size) {
+        return false;
+    }
+
+    target[ledIndex] = color;
+    if (mask) mask[ledIndex] = 1;
+    return true;
+}
+
+bool FrameCompositor::setZone(int deviceIndex, int zoneIndex, RGBColor color)
+{
+    if (!_deviceManager || deviceIndex < 0 || static_cast<size_t>(deviceIndex) >= _devices.size()) return false;
+
+    unsigned int start = 0;
+    unsigned int count = 0;
+    if (!_deviceManager->GetZoneRange(_devices[deviceIndex], zoneIndex, start, count)) {
+        return false;
+    }
+
+    size_t size = 0;
+    uint8_t* mask = nullptr;
+    RGBColor* target = acquireTarget(deviceIndex, size, mask);
+    if (!target) return false;
+
+    size_t end = std::min(static_cast<size_t>(start) + count, size);
+    if (start >= end) return false;
+
+    std::fill(target + start, target + end, color);
+    if (mask) std::fill(mask + start, mask + end, uint8_t(1));
+    return true;
+}
+
+bool FrameCompositor::setDevice(int deviceIndex, RGBColor color)
+{
+    size_t size = 0;
+    uint8_t* mask = nullptr;
+    RGBColor* target = acquireTarget(deviceIndex, size, mask);
+    if (!target) return false;
+
+    std::fill(target, target + size, color);
+    if (mask) std::fill(mask, mask + size, uint8_t(1));
+    return true;
+}
+
+bool FrameCompositor::hasPendingOutput() const
+{
+    return getTouchedControllerCount() > 0;
+}
+
+int FrameCompositor::getTouchedControllerCount() const
+{
+    int touched = 0;
+    for (auto it = _buffers.constBegin(); it != _buffers.constEnd(); ++it) {
+        if (it.value().touched) touched++;
+    }
+    return touched;
+}
+
+FrameCompositor::ControllerBuffer* FrameCompositor::acquireBuffer(int deviceIndex)
+{
+    if (!_deviceManager) return nullptr;
+    if (deviceIndex < 0 || static_cast<size_t>(deviceIndex) >= _devices.size()) return nullptr;
+
+    const DeviceHandle& device = _devices[deviceIndex];
+    if (!device.IsValid()) return nullptr;
+
+    ControllerBuffer& buffer = _buffers[deviceIndex];
+    if (!buffer.touched) {
+        // First write this frame: start from the controller's base, so LEDs that
+        // no effect owns keep their color and layers never blend onto last frame
+        buffer.device = device;
+        auto found = _baseColors.find(device.index);
+        bool current = (found != _baseColors.end() &&
+                        found->second.device.generation == device.generation &&
+                        found->second.device.controller == device.controller);
+        if (!current) {
+            BaseColors& base = _baseColors[device.index];
+            if (!loadBaseColors(device, base)) {
+                _baseColors.erase(device.index);
+                _buffers.remove(deviceIndex);
+                return nullptr;
+            }
+            found = _baseColors.find(device.index);
+        } else if (_deviceManager->GetDeviceColors(device, _currentColors)) {
+            // LEDs the compositor never changed show whatever was set from outside
+            BaseColors& base = found->second;
+            for (size_t i = 0; i < base.colors.size() && i < _currentColors.size(); i++) {
+                if (!base.written[i]) base.colors[i] = _currentColors[i];
+            }
+        }
+        buffer.colors.assign(found->second.colors.begin(), found->second.colors.end());
+        buffer.touched = true;
+    }
+
+    return &buffer;
+}
+
+RGBColor* FrameCompositor::acquireTarget(int deviceIndex, size_t& size, uint8_t*& mask)
+{
+    ControllerBuffer* buffer = acquireBuffer(deviceIndex);
+    if (!buffer) return nullptr;
+
+    size = buffer->colors.size();
+    if (!_inLayer) {
+        mask = nullptr;
+        return buffer->colors.data();
+    }
+
+    if (!buffer->layerTouched) {
+        // First write of this layer: nothing is covered yet
+        buffer->layerColors.resize(size);
+        buffer->layerMask.assign(size, 0);
+        buffer->layerTouched = true;
+    }
+
+    mask = buffer->layerMask.data();
+    return buffer->layerColors.data();
+}
+
+} // namespace Lightscape
@@ -0,0 +1,77 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameScheduler.cpp                                        |
+|                                                           |
+| Fixed-timestep frame pacing for the render thread         |
+\*---------------------------------------------------------*/
+
+#include "effects/FrameScheduler.h"
+#include <thread>
+
+namespace Lightscape {
+
+constexpr std::chrono::microseconds FrameScheduler::SpinWindow;
+
+FrameScheduler::FrameScheduler()
+    : _interval(33333)
+    , _nextDeadline(Clock::now())
+    , _frameCount(0)
+    , _droppedFrames(0)
+{
+}
+
+void FrameScheduler::setInterval(std::chrono::microseconds interval)
+{
+    if (interval.count() <= 0) return;
+
+    _interval = interval;
+
+    // Re-anchor so the new rate starts from now instead of the old timeline
+    reset();
+}
+
+void FrameScheduler::reset()
+{
+    _nextDeadline = Clock::now();
+}
+
+float FrameScheduler::waitForNextFrame()
+{
+    _nextDeadline += _interval;
+
+    Clock::time_point now = Clock::now();
+    int64_t framesAdvanced = 1;
+
+    if (now < _nextDeadline) {
+        // Coarse sleep first, the OS timer is only accurate to about a millisecond
+        if (_nextDeadline - now > SpinWindow) {
+            std::this_thread::sleep_until(_nextDeadline - SpinWindow);
+        }
+
+        while (Clock::now() < _nextDeadline) {
+            std::this_thread::yield();
+        }
+    } else {
+        // We are late: skip every deadline that has already passed
+        int64_t missed = (now - _nextDeadline) / _interval;
+        if (missed > 0) {
+            _droppedFrames.fetch_add(static_cast<uint64_t>(missed), std::memory_order_relaxed);
+            _nextDeadline += _interval * missed;
+            framesAdvanced += missed;
+        }
+    }
+
+    _frameCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Advance the simulation by every frame slot that elapsed, so animation keeps wall-clock speed
+    return std::chrono::duration<float>(_interval * framesAdvanced).count();
+}
+
+void FrameScheduler::resetStatistics()
+{
+    _frameCount.store(0, std::memory_order_relaxed);
+    _droppedFrames.store(0, std::memory_order_relaxed);
+}
+
+} // namespace Lightscape
@@ -0,0 +1,148 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameStatistics.cpp                                       |
+|                                                           |
+| Rolling per-stage frame timing for the render thread      |
+\*---------------------------------------------------------*/
+
+#include "effects/FrameStatistics.h"
+#include <algorithm>
+
+namespace Lightscape {
+
+namespace {
+
+uint32_t toMicroseconds(FrameStatistics::Clock::duration elapsed)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    return static_cast<uint32_t>(std::max<int64_t>(0, us));
+}
+
+} // namespace
+
+const char* frameStageName(FrameStage stage)
+{
+    switch (stage) {
+        case FrameStage::EffectUpdate:    return "Effect update";
+        case FrameStage::ColorEvaluation: return "Color evaluation";
+        case FrameStage::Compositing:     return "Compositing";
+        case FrameStage::DeviceFlush:     return "Device flush";
+        case FrameStage::Preview:         return "Preview";
+        case FrameStage::Total:           return "Total";
+        case FrameStage::Count:           break;
+    }
+    return "";
+}
+
+constexpr int TimingWindow::Capacity;
+
+void TimingWindow::record(uint32_t microseconds)
+{
+    _samples[_next] = microseconds;
+    _next = (_next + 1) % Capacity;
+    _count = std::min(_count + 1, Capacity);
+}
+
+TimingSummary TimingWindow::summarize() const
+{
+    TimingSummary summary;
+    summary.samples = _count;
+    if (_count == 0) return summary;
+
+    std::vector<uint32_t> sorted(_samples.begin(), _samples.begin() + _count);
+    std::sort(sorted.begin(), sorted.end());
+
+    auto percentile = [&sorted](int p) {
+        size_t index = (sorted.size() - 1) * p / 100;
+        return sorted[index];
+    };
+
+    summary.p50 = percentile(50);
+    summary.p95 = percentile(95);
+    summary.p99 = percentile(99);
+    summary.max = sorted.back();
+    return summary;
+}
+
+void TimingWindow::clear()
+{
+    _next = 0;
+    _count = 0;
+}
+
+void FrameStatistics::beginFrame(std::chrono::microseconds budget)
+{
+    _frameStages.fill(Clock::duration::zero());
+    _frameFlushes.clear();
+    _frameBudget = static_cast<uint32_t>(budget.count());
+    _frameStart = Clock::now();
+}
+
+void FrameStatistics::addStageTime(FrameStage stage, Clock::duration elapsed)
+{
+    _frameStages[static_cast<int>(stage)] += elapsed;
+}
+
+void FrameStatistics::addControllerFlushTime(int deviceIndex, Clock::duration elapsed)
+{
+    _frameFlushes.emplace_back(deviceIndex, toMicroseconds(elapsed));
+}
+
+void FrameStatistics::endFrame(uint64_t droppedFrames)
+{
+    uint32_t total = toMicroseconds(Clock::now() - _frameStart);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (int i = 0; i < static_cast<int>(FrameStage::Total); i++) {
+        _stages[i].record(toMicroseconds(_frameStages[i]));
+    }
+    _stages[static_cast<int>(FrameStage::Total)].record(total);
+
+    for (const auto& flush : _frameFlushes) {
+        _controllerFlush[flush.first].record(flush.second);
+    }
+
+    _frames++;
+    if (_frameBudget > 0 && total > _frameBudget) {
+        _overruns++;
+    }
+    _dropped = droppedFrames;
+    _budget = _frameBudget;
+}
+
+FrameStatistics::Snapshot FrameStatistics::snapshot() const
+{
+    Snapshot result;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (int i = 0; i < static_cast<int>(FrameStage::Count); i++) {
+        result.stages[i] = _stages[i].summarize();
+    }
+    for (auto it = _controllerFlush.constBegin(); it != _controllerFlush.constEnd(); ++it) {
+        result.controllerFlush[it.key()] = it.value().summarize();
+    }
+
+    result.frames = _frames;
+    result.overruns = _overruns;
+    result.dropped = _dropped;
+    result.budget = _budget;
+    return result;
+}
+
+void FrameStatistics::reset()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (TimingWindow& window : _stages) {
+        window.clear();
+    }
+    _controllerFlush.clear();
+    _frames = 0;
+    _overruns = 0;
+    _dropped = 0;
+}
+
+} // namespace Lightscape
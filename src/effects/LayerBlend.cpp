@@ -0,0 +1,157 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| LayerBlend.cpp                                            |
+|                                                           |
+| Blend modes and kernels for effect layer compositing      |
+\*---------------------------------------------------------*/
+
+#include "effects/LayerBlend.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHTSCAPE_BLEND_SSE2 1
+#endif
+
+namespace Lightscape {
+
+namespace {
+
+// Exact round(a * b / 255) for a, b in 0..255
+inline uint32_t mul255(uint32_t a, uint32_t b)
+{
+    uint32_t t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+template<BlendMode Mode>
+inline uint32_t blendChannel(uint32_t d, uint32_t s)
+{
+    switch (Mode) {
+        case BlendMode::Add:      return std::min<uint32_t>(255, d + s);
+        case BlendMode::Multiply: return mul255(d, s);
+        case BlendMode::Screen:   return 255 - mul255(255 - d, 255 - s);
+        case BlendMode::Max:      return std::max(d, s);
+        case BlendMode::Normal:
+        case BlendMode::Alpha:    return s;
+    }
+    return s;
+}
+
+// The mode is a template parameter so every kernel is a branch-free inner loop
+template<BlendMode Mode>
+void blendScalar(uint8_t opacity, const RGBColor* src, const uint8_t* mask, RGBColor* dst, size_t begin, size_t count)
+{
+    for (size_t i = begin; i < count; i++) {
+        if (!mask[i]) continue;
+
+        uint32_t d = dst[i];
+        uint32_t s = src[i];
+        uint32_t dr = d & 0xFF, dg = (d >> 8) & 0xFF, db = (d >> 16) & 0xFF;
+        uint32_t sr = s & 0xFF, sg = (s >> 8) & 0xFF, sb = (s >> 16) & 0xFF;
+
+        uint32_t alpha = opacity;
+        if (Mode == BlendMode::Alpha) {
+            alpha = mul255(alpha, std::max(sr, std::max(sg, sb)));
+        }
+
+        uint32_t r = blendChannel<Mode>(dr, sr);
+        uint32_t g = blendChannel<Mode>(dg, sg);
+        uint32_t b = blendChannel<Mode>(db, sb);
+
+        if (alpha != 255) {
+            uint32_t inv = 255 - alpha;
+            r = mul255(r, alpha) + mul255(dr, inv);
+            g = mul255(g, alpha) + mul255(dg, inv);
+            b = mul255(b, alpha) + mul255(db, inv);
+        }
+
+        dst[i] = std::min<uint32_t>(r, 255) | (std::min<uint32_t>(g, 255) << 8) | (std::min<uint32_t>(b, 255) << 16);
+    }
+}
+
+#ifdef LIGHTSCAPE_BLEND_SSE2
+// Full-opacity Normal/Add/Max, four LEDs per iteration. Returns how many LEDs were done.
+size_t blendSSE2(BlendMode mode, const RGBColor* src, const uint8_t* mask, RGBColor* dst, size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        __m128i out;
+        switch (mode) {
+            case BlendMode::Add: out = _mm_adds_epu8(d, s); break;
+            case BlendMode::Max: out = _mm_max_epu8(d, s); break;
+            default:             out = s; break;
+        }
+
+        // Widen the four mask bytes into four 32-bit lane selectors
+        int32_t maskBits;
+        std::memcpy(&maskBits, mask + i, sizeof(maskBits));
+        __m128i lanes = _mm_cvtsi32_si128(maskBits);
+        lanes = _mm_unpacklo_epi8(lanes, zero);
+        lanes = _mm_unpacklo_epi16(lanes, zero);
+        __m128i select = _mm_cmpgt_epi32(lanes, zero);
+
+        __m128i result = _mm_or_si128(_mm_and_si128(select, out), _mm_andnot_si128(select, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+    }
+
+    return i;
+}
+#endif
+
+} // namespace
+
+QString blendModeToString(BlendMode mode)
+{
+    switch (mode) {
+        case BlendMode::Normal:   return "normal";
+        case BlendMode::Add:      return "add";
+        case BlendMode::Multiply: return "multiply";
+        case BlendMode::Screen:   return "screen";
+        case BlendMode::Max:      return "max";
+        case BlendMode::Alpha:    return "alpha";
+    }
+    return "normal";
+}
+
+BlendMode blendModeFromString(const QString& name)
+{
+    QString key = name.toLower();
+    if (key == "add")      return BlendMode::Add;
+    if (key == "multiply") return BlendMode::Multiply;
+    if (key == "screen")   return BlendMode::Screen;
+    if (key == "max")      return BlendMode::Max;
+    if (key == "alpha")    return BlendMode::Alpha;
+    return BlendMode::Normal;
+}
+
+void blendLayer(BlendMode mode, uint8_t opacity, const RGBColor* src, const uint8_t* mask,
+                RGBColor* dst, size_t count)
+{
+    if (opacity == 0 || count == 0) return;
+
+    size_t done = 0;
+#ifdef LIGHTSCAPE_BLEND_SSE2
+    if (opacity == 255 && (mode == BlendMode::Normal || mode == BlendMode::Add || mode == BlendMode::Max)) {
+        done = blendSSE2(mode, src, mask, dst, count);
+    }
+#endif
+
+    switch (mode) {
+        case BlendMode::Normal:   blendScalar<BlendMode::Normal>(opacity, src, mask, dst, done, count); break;
+        case BlendMode::Add:      blendScalar<BlendMode::Add>(opacity, src, mask, dst, done, count); break;
+        case BlendMode::Multiply: blendScalar<BlendMode::Multiply>(opacity, src, mask, dst, done, count); break;
+        case BlendMode::Screen:   blendScalar<BlendMode::Screen>(opacity, src, mask, dst, done, count); break;
+        case BlendMode::Max:      blendScalar<BlendMode::Max>(opacity, src, mask, dst, done, count); break;
+        case BlendMode::Alpha:    blendScalar<BlendMode::Alpha>(opacity, src, mask, dst, done, count); break;
+    }
+}
+
+} // namespace Lightscape
@@ -95,6 +95,27 @@ void PreviewRenderer2D::drawCells(QPainter& painter, const GridDimensions& dims,
                                 float offsetX, float offsetY, SpatialGrid* grid, BaseEffect* effect, 
                                 int activeLayer, bool deviceOnlyMode, const QSet<GridPosition>& devicePositions)
 {
+    // Evaluate the effect for every cell that shows it in a single batch call
+    bool effectActive = effect && effect->getEnabled();
+    _cellPositions.clear();
+    if (effectActive) {
+        for (int y = 0; y < dims.height; y++) {
+            for (int x = 0; x < dims.width; x++) {
+                GridPosition pos(x, y, activeLayer);
+                if (!deviceOnlyMode || devicePositions.contains(pos)) {
+                    _cellPositions.append(pos);
+                }
+            }
+        }
+        
+        // Use the effect's internal time to match real device animation
+        _cellColors.resize(_cellPositions.size());
+        if (!_cellPositions.isEmpty()) {
+            effect->getOutputColors(_cellPositions, effect->getInternalTime(), effect->parameters(), _cellColors.data());
+        }
+    }
+    size_t nextEffectColor = 0;
+    
     for (int y = 0; y < dims.height; y++) {
         for (int x = 0; x < dims.width; x++) {
             GridPosition pos(x, y, activeLayer);
@@ -102,7 +123,7 @@ void PreviewRenderer2D::drawCells(QPainter& painter, const GridDimensions& dims,
             // Get color from effect or use default if no effect is active
             RGBColor rgbColor;
             
-            if (!effect || !effect->getEnabled()) {
+            if (!effectActive) {
                 // Use a checkerboard pattern for visibility when no effect or disabled effect
                 bool isOdd = ((pos.x + pos.y) % 2 == 1);
                 rgbColor = isOdd ? ToRGBColor(60, 60, 70) : ToRGBColor(50, 50, 60);
@@ -121,11 +142,10 @@ void PreviewRenderer2D::drawCells(QPainter& painter, const GridDimensions& dims,
                         // Use a default grey for non-device positions
                         rgbColor = ToRGBColor(100, 100, 100); // Medium grey
                     } else {
-                        rgbColor = effect->getColorForPosition(pos, effect->getInternalTime());
+                        rgbColor = _cellColors[nextEffectColor++];
                     }
                 } else {
-                    // Use the effect's internal time to match real device animation
-                    rgbColor = effect->getColorForPosition(pos, effect->getInternalTime());
+                    rgbColor = _cellColors[nextEffectColor++];
                 }
             }
             
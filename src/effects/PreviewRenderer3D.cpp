@@ -69,8 +69,33 @@ void PreviewRenderer3D::draw(QPainter& painter, int width, int height, SpatialGr
         drawGridOutlines(painter, dims, cellSize, layerSpacing, transform, centerX, centerY, grid);
     }
     
-    // Collect all cells
-    std::vector<CellInfo> cells;
+    // Evaluate the effect for every cell that shows it in a single batch call
+    bool effectActive = effect && effect->getEnabled();
+    _cellPositions.clear();
+    if (effectActive) {
+        for (int z = 0; z < dims.depth; z++) {
+            for (int y = 0; y < dims.height; y++) {
+                for (int x = 0; x < dims.width; x++) {
+                    GridPosition pos(x, y, z);
+                    if (!deviceOnlyMode || devicePositions.contains(pos)) {
+                        _cellPositions.append(pos);
+                    }
+                }
+            }
+        }
+        
+        // Use the effect's internal time to match real device animation
+        _cellColors.resize(_cellPositions.size());
+        if (!_cellPositions.isEmpty()) {
+            effect->getOutputColors(_cellPositions, effect->getInternalTime(), effect->parameters(), _cellColors.data());
+        }
+    }
+    size_t nextEffectColor = 0;
+    
+    // Collect all cells (in the arena, so a repaint doesn't allocate per cell)
+    _frameArena.reset();
+    Span<CellInfo> cells = _frameArena.allocate<CellInfo>(static_cast<size_t>(dims.width) * dims.height * dims.depth);
+    size_t nextCell = 0;
     
     // Add all cells with their 3D positions
     for (int z = 0; z < dims.depth; z++) {
@@ -84,7 +109,7 @@ void PreviewRenderer3D::draw(QPainter& painter, int width, int height, SpatialGr
                 // Get color from effect or use default if no effect is active
                 RGBColor rgbColor;
                 
-                if (!effect || !effect->getEnabled()) {
+                if (!effectActive) {
                     // Use a checkerboard pattern for visibility when no effect or disabled effect
                     bool isOdd = ((pos.x + pos.y + pos.z) % 2 == 1);
                     rgbColor = isOdd ? ToRGBColor(60, 60, 70) : ToRGBColor(50, 50, 60);
@@ -103,11 +128,10 @@ void PreviewRenderer3D::draw(QPainter& painter, int width, int height, SpatialGr
                             // Use a default grey for non-device positions
                             rgbColor = ToRGBColor(100, 100, 100); // Medium grey
                         } else {
-                            // Use the effect's internal time to match real device animation
-                            rgbColor = effect->getColorForPosition(pos, effect->getInternalTime());
+                            rgbColor = _cellColors[nextEffectColor++];
                         }
                     } else {
-                        rgbColor = effect->getColorForPosition(pos, effect->getInternalTime());
+                        rgbColor = _cellColors[nextEffectColor++];
                     }
                 }
                 QColor cellColor(RGBGetRValue(rgbColor), RGBGetGValue(rgbColor), RGBGetBValue(rgbColor));
@@ -122,48 +146,32 @@ void PreviewRenderer3D::draw(QPainter& painter, int width, int height, SpatialGr
                 float halfHeight = cellSize * 0.45f;
                 float halfDepth = cellSize * 0.15f;
                 
-                QVector<QVector3D> corners;
-                // Front face (lower Z)
-                corners.append(QVector3D(center.x() - halfWidth, center.y() - halfHeight, center.z() - halfDepth)); // Front top-left
-                corners.append(QVector3D(center.x() + halfWidth, center.y() - halfHeight, center.z() - halfDepth)); // Front top-right
-                corners.append(QVector3D(center.x() + halfWidth, center.y() + halfHeight, center.z() - halfDepth)); // Front bottom-right
-                corners.append(QVector3D(center.x() - halfWidth, center.y() + halfHeight, center.z() - halfDepth)); // Front bottom-left
-                // Back face (higher Z)
-                corners.append(QVector3D(center.x() - halfWidth, center.y() - halfHeight, center.z() + halfDepth)); // Back top-left
-                corners.append(QVector3D(center.x() + halfWidth, center.y() - halfHeight, center.z() + halfDepth)); // Back top-right
-                corners.append(QVector3D(center.x() + halfWidth, center.y() + halfHeight, center.z() + halfDepth)); // Back bottom-right
-                corners.append(QVector3D(center.x() - halfWidth, center.y() + halfHeight, center.z() + halfDepth)); // Back bottom-left
-                
-                // Project corners to 2D
-                QVector<QPointF> projectedCorners;
-                for (const auto& corner : corners) {
-                    projectedCorners.append(project(corner, transform, centerX, centerY));
-                }
-                
-                // Get transformed position for depth sorting
-                QVector3D transformedPos = transform * center;
-                
-                // Create position label
-                QString label = "P" + QString::number(x + y * dims.width + 1);
-                if (grid) {
-                    QString gridLabel = grid->GetPositionLabel(pos);
-                    if (!gridLabel.isEmpty()) {
-                        label = gridLabel;
-                    }
-                }
+                const QVector3D corners[8] = {
+                    // Front face (lower Z)
+                    QVector3D(center.x() - halfWidth, center.y() - halfHeight, center.z() - halfDepth), // Front top-left
+                    QVector3D(center.x() + halfWidth, center.y() - halfHeight, center.z() - halfDepth), // Front top-right
+                    QVector3D(center.x() + halfWidth, center.y() + halfHeight, center.z() - halfDepth), // Front bottom-right
+                    QVector3D(center.x() - halfWidth, center.y() + halfHeight, center.z() - halfDepth), // Front bottom-left
+                    // Back face (higher Z)
+                    QVector3D(center.x() - halfWidth, center.y() - halfHeight, center.z() + halfDepth), // Back top-left
+                    QVector3D(center.x() + halfWidth, center.y() - halfHeight, center.z() + halfDepth), // Back top-right
+                    QVector3D(center.x() + halfWidth, center.y() + halfHeight, center.z() + halfDepth), // Back bottom-right
+                    QVector3D(center.x() - halfWidth, center.y() + halfHeight, center.z() + halfDepth), // Back bottom-left
+                };
                 
-                // Add to cells list
-                CellInfo cellInfo;
+                // Add to cells list, with the corners projected to 2D
+                CellInfo& cellInfo = cells[nextCell++];
                 cellInfo.x = x;
                 cellInfo.y = y;
                 cellInfo.z = z;
                 cellInfo.color = cellColor;
                 cellInfo.center = center;
-                cellInfo.depth = transformedPos.z();
-                cellInfo.label = label;
-                cellInfo.projectedCorners = projectedCorners;
+                for (int i = 0; i < 8; i++) {
+                    cellInfo.projectedCorners[i] = project(corners[i], transform, centerX, centerY);
+                }
                 
-                cells.push_back(cellInfo);
+                // Get transformed position for depth sorting
+                cellInfo.depth = (transform * center).z();
             }
         }
     }
@@ -174,7 +182,7 @@ void PreviewRenderer3D::draw(QPainter& painter, int width, int height, SpatialGr
     });
     
     // Draw all cells
-    drawCells(painter, cells, dims, cellSize);
+    drawCells(painter, cells, dims, cellSize, grid);
     
     // Draw controls hint
     drawControls(painter, width, height);
@@ -203,16 +211,17 @@ void PreviewRenderer3D::drawGridOutlines(QPainter& painter, const GridDimensions
         float halfWidth = dims.width * cellSize / 2.0f;
         float halfHeight = dims.height * cellSize / 2.0f;
         
-        QVector<QVector3D> corners;
-        corners.append(QVector3D(-halfWidth, -halfHeight, zPos)); // Top-left
-        corners.append(QVector3D(halfWidth, -halfHeight, zPos));  // Top-right
-        corners.append(QVector3D(halfWidth, halfHeight, zPos));   // Bottom-right
-        corners.append(QVector3D(-halfWidth, halfHeight, zPos));  // Bottom-left
+        const QVector3D corners[4] = {
+            QVector3D(-halfWidth, -halfHeight, zPos), // Top-left
+            QVector3D(halfWidth, -halfHeight, zPos),  // Top-right
+            QVector3D(halfWidth, halfHeight, zPos),   // Bottom-right
+            QVector3D(-halfWidth, halfHeight, zPos),  // Bottom-left
+        };
         
         // Project to 2D
-        QVector<QPointF> projectedCorners;
-        for (const auto& corner : corners) {
-            projectedCorners.append(project(corner, transform, centerX, centerY));
+        QPointF projectedCorners[4];
+        for (int i = 0; i < 4; i++) {
+            projectedCorners[i] = project(corners[i], transform, centerX, centerY);
         }
         
         // Draw the layer outline
@@ -257,8 +266,8 @@ void PreviewRenderer3D::drawGridOutlines(QPainter& painter, const GridDimensions
     }
 }
 
-void PreviewRenderer3D::drawCells(QPainter& painter, std::vector<CellInfo>& cells, 
-                                const GridDimensions& dims, float cellSize)
+void PreviewRenderer3D::drawCells(QPainter& painter, ConstSpan<CellInfo> cells, 
+                                const GridDimensions& dims, float cellSize, SpatialGrid* grid)
 {
     Q_UNUSED(cellSize); // Mark parameter as unused to avoid compiler warning
     for (const auto& cell : cells) {
@@ -276,41 +285,35 @@ void PreviewRenderer3D::drawCells(QPainter& painter, std::vector<CellInfo>& cell
         
         // First draw back faces (those facing away from viewer)
         // Back face
-        QPolygonF backFace;
-        backFace << cell.projectedCorners[4] << cell.projectedCorners[5] << cell.projectedCorners[6] << cell.projectedCorners[7];
+        const QPointF backFace[4] = { cell.projectedCorners[4], cell.projectedCorners[5], cell.projectedCorners[6], cell.projectedCorners[7] };
         painter.setBrush(backColor);
-        painter.drawPolygon(backFace);
+        painter.drawPolygon(backFace, 4);
         
         // Bottom face
-        QPolygonF bottomFace;
-        bottomFace << cell.projectedCorners[3] << cell.projectedCorners[2] << cell.projectedCorners[6] << cell.projectedCorners[7];
+        const QPointF bottomFace[4] = { cell.projectedCorners[3], cell.projectedCorners[2], cell.projectedCorners[6], cell.projectedCorners[7] };
         painter.setBrush(bottomColor);
-        painter.drawPolygon(bottomFace);
+        painter.drawPolygon(bottomFace, 4);
         
         // Right face
-        QPolygonF rightFace;
-        rightFace << cell.projectedCorners[1] << cell.projectedCorners[2] << cell.projectedCorners[6] << cell.projectedCorners[5];
+        const QPointF rightFace[4] = { cell.projectedCorners[1], cell.projectedCorners[2], cell.projectedCorners[6], cell.projectedCorners[5] };
         painter.setBrush(rightColor);
-        painter.drawPolygon(rightFace);
+        painter.drawPolygon(rightFace, 4);
         
         // Then draw front faces
         // Left face
-        QPolygonF leftFace;
-        leftFace << cell.projectedCorners[0] << cell.projectedCorners[3] << cell.projectedCorners[7] << cell.projectedCorners[4];
+        const QPointF leftFace[4] = { cell.projectedCorners[0], cell.projectedCorners[3], cell.projectedCorners[7], cell.projectedCorners[4] };
         painter.setBrush(leftColor);
-        painter.drawPolygon(leftFace);
+        painter.drawPolygon(leftFace, 4);
         
         // Top face
-        QPolygonF topFace;
-        topFace << cell.projectedCorners[0] << cell.projectedCorners[1] << cell.projectedCorners[5] << cell.projectedCorners[4];
+        const QPointF topFace[4] = { cell.projectedCorners[0], cell.projectedCorners[1], cell.projectedCorners[5], cell.projectedCorners[4] };
         painter.setBrush(topColor);
-        painter.drawPolygon(topFace);
+        painter.drawPolygon(topFace, 4);
         
         // Front face
-        QPolygonF frontFace;
-        frontFace << cell.projectedCorners[0] << cell.projectedCorners[1] << cell.projectedCorners[2] << cell.projectedCorners[3];
+        const QPointF frontFace[4] = { cell.projectedCorners[0], cell.projectedCorners[1], cell.projectedCorners[2], cell.projectedCorners[3] };
         painter.setBrush(frontColor);
-        painter.drawPolygon(frontFace);
+        painter.drawPolygon(frontFace, 4);
         
         // Add thin dark border to all faces for solid appearance
         QPen borderPen(QColor(30, 30, 30, 80), 0.5f); // Thinner, more transparent border
@@ -318,12 +321,12 @@ void PreviewRenderer3D::drawCells(QPainter& painter, std::vector<CellInfo>& cell
         painter.setBrush(Qt::NoBrush);
         
         // Draw borders for all faces
-        painter.drawPolygon(frontFace);
-        painter.drawPolygon(topFace);
-        painter.drawPolygon(leftFace);
-        painter.drawPolygon(rightFace);
-        painter.drawPolygon(bottomFace);
-        painter.drawPolygon(backFace);
+        painter.drawPolygon(frontFace, 4);
+        painter.drawPolygon(topFace, 4);
+        painter.drawPolygon(leftFace, 4);
+        painter.drawPolygon(rightFace, 4);
+        painter.drawPolygon(bottomFace, 4);
+        painter.drawPolygon(backFace, 4);
         
         // Draw position label on top face
         if (dims.width <= 8 && dims.height <= 8) {
@@ -335,9 +338,15 @@ void PreviewRenderer3D::drawCells(QPainter& painter, std::vector<CellInfo>& cell
             int brightness = (topColor.red() + topColor.green() + topColor.blue()) / 3;
             painter.setPen(brightness > 128 ? Qt::black : Qt::white);
             
+            // Labels are only built for cells that show one
+            QString label = grid ? grid->GetPositionLabel(GridPosition(cell.x, cell.y, cell.z)) : QString();
+            if (label.isEmpty()) {
+                label = "P" + QString::number(cell.x + cell.y * dims.width + 1);
+            }
+            
             // Draw the label
             QRectF textRect(labelPos.x() - 12, labelPos.y() - 8, 24, 16);
-            painter.drawText(textRect, Qt::AlignCenter, cell.label);
+            painter.drawText(textRect, Qt::AlignCenter, label);
         }
     }
 }
@@ -1,5 +1,8 @@
 #include "effects/SpatialControllerZone.h"
+#include "effects/FrameCompositor.h"
+#include "effects/ColorScale.h"
 #include "devices/DeviceManager.h"
+#include "grid/SpatialField.h"
 #include "core/Types.h"
 #include <cmath>
 
@@ -15,6 +18,8 @@ SpatialControllerZone::SpatialControllerZone(int device_index, int zone_index, c
 
 float SpatialControllerZone::getDistanceFrom(const GridPosition& reference) const
 {
+    if (field && field->GetReference() == reference) return getDistanceFrom(*field);
+    
     float dx = position.x - reference.x;
     float dy = position.y - reference.y;
     float dz = position.z - reference.z;
@@ -23,6 +28,8 @@ float SpatialControllerZone::getDistanceFrom(const GridPosition& reference) cons
 
 float SpatialControllerZone::getAngleFrom(const GridPosition& reference, int axis) const
 {
+    if (field && field->GetReference() == reference) return getAngleFrom(*field, axis);
+    
     // Calculate the angle in radians based on axis (0 = XY, 1 = XZ, 2 = YZ)
     float dx = position.x - reference.x;
     float dy = position.y - reference.y;
@@ -41,6 +48,17 @@ float SpatialControllerZone::getAngleFrom(const GridPosition& reference, int axi
     }
 }
 
+float SpatialControllerZone::getDistanceFrom(const SpatialField& field) const
+{
+    return field.GetDistance(position);
+}
+
+float SpatialControllerZone::getAngleFrom(const SpatialField& field, int axis) const
+{
+    if (axis < 0 || axis > 2) return 0.0f;
+    return field.GetAngle(position, static_cast<SpatialField::Plane>(axis));
+}
+
 unsigned int SpatialControllerZone::getLEDCount() const
 {
     if (!deviceManager) return 0;
@@ -51,32 +69,32 @@ void SpatialControllerZone::setLED(int led_idx, RGBColor color, int brightness,
 {
     if (!deviceManager) return;
     
-    // Apply brightness
-    float brightnessF = brightness / 100.0f;
-    int r = static_cast<int>(RGBGetRValue(color) * brightnessF);
-    int g = static_cast<int>(RGBGetGValue(color) * brightnessF);
-    int b = static_cast<int>(RGBGetBValue(color) * brightnessF);
+    // Apply brightness (effects pass 100, they scale the frame themselves)
+    RGBColor finalColor = (brightness == 100) ? color : scaleColor(color, brightness);
     
     // Apply other adjustments if needed (temperature, tint)
     
     // Set the LED color
-    RGBColor finalColor = ToRGBColor(r, g, b);
-    deviceManager->SetLEDColor(deviceIndex, led_idx, finalColor);
+    if (compositor) {
+        compositor->setLED(deviceIndex, led_idx, finalColor);
+    } else {
+        deviceManager->SetLEDColor(deviceIndex, led_idx, finalColor);
+    }
 }
 
 void SpatialControllerZone::setAllLEDs(RGBColor color, int brightness, int /*temperature*/, int /*tint*/)
 {
     if (!deviceManager) return;
     
-    // Apply brightness
-    float brightnessF = brightness / 100.0f;
-    int r = static_cast<int>(RGBGetRValue(color) * brightnessF);
-    int g = static_cast<int>(RGBGetGValue(color) * brightnessF);
-    int b = static_cast<int>(RGBGetBValue(color) * brightnessF);
+    // Apply brightness (effects pass 100, they scale the frame themselves)
+    RGBColor finalColor = (brightness == 100) ? color : scaleColor(color, brightness);
     
     // Set the zone color
-    RGBColor finalColor = ToRGBColor(r, g, b);
-    deviceManager->SetZoneColor(deviceIndex, zoneIndex, finalColor);
+    if (compositor) {
+        compositor->setZone(deviceIndex, zoneIndex, finalColor);
+    } else {
+        deviceManager->SetZoneColor(deviceIndex, zoneIndex, finalColor);
+    }
 }
 
 bool SpatialControllerZone::isMatrix() const
@@ -1,11 +1,14 @@
 #include "effects/TestEffect/TestEffect.h"
 #include "effects/SpatialControllerZone.h"
+#include "core/LoggingManager.h"
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QSlider>
 #include <QPushButton>
 #include <QColorDialog>
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
 
 namespace Lightscape {
 
@@ -63,12 +66,12 @@ TestEffect::TestEffect(QWidget *parent)
     
     // Connect signals
     connect(speedSlider, &QSlider::valueChanged, this, [this](int value) {
-        speed = value;
+        setSpeed(value);
         emit settingsChanged();
     });
     
     connect(brightnessSlider, &QSlider::valueChanged, this, [this](int value) {
-        brightness = value;
+        setBrightness(value);
         emit settingsChanged();
     });
     
@@ -113,8 +116,7 @@ TestEffect::TestEffect(QWidget *parent)
         QColor color = QColorDialog::getColor(initial, this, "Select Effect Color");
         
         if (color.isValid()) {
-            userColors.clear();
-            userColors.append(ToRGBColor(color.red(), color.green(), color.blue()));
+            setColors({ ToRGBColor(color.red(), color.green(), color.blue()) });
             emit settingsChanged();
         }
     });
@@ -141,49 +143,83 @@ EffectInfo TestEffect::GetStaticInfo()
     info.category = EffectCategory::Basic;
     info.requiresReferencePoint = false;
     info.supportsPreview = true;
-    printf("[Lightscape][TestEffect] GetStaticInfo created with name: %s, ID: %s\n", 
-           info.name.toStdString().c_str(), 
-           info.id.toStdString().c_str());
+    LOG_TRACE("[Lightscape][TestEffect] GetStaticInfo created with name: %s, ID: %s", 
+              qPrintable(info.name), 
+              qPrintable(info.id));
     return info;
 }
 
 RGBColor TestEffect::getColorForPosition(const GridPosition& pos, float time)
 {
+    // Read the published settings, this may be called from any thread
+    EffectParameters params = parameters();
+    
     // Modify calculations based on selected settings
-    float speedFactor = speed / 50.0f; // Normalize to make 50 the default speed
+    float speedFactor = params.speed / 50.0f; // Normalize to make 50 the default speed
     
     // If user has selected colors, use them instead of position-based colors
-    if (!userColors.isEmpty()) {
-        RGBColor baseColor = userColors.first();
+    if (params.hasColors()) {
+        RGBColor baseColor = params.colors[0];
         
         // Create a pulsing effect based on time and speed
         float pulse = (sin(time * speedFactor * 3.0f) + 1.0f) / 2.0f;
         
-        // Apply brightness
-        float brightnessFactor = brightness / 100.0f;
-        int r = RGBGetRValue(baseColor) * brightnessFactor * pulse;
-        int g = RGBGetGValue(baseColor) * brightnessFactor * pulse;
-        int b = RGBGetBValue(baseColor) * brightnessFactor * pulse;
+        int r = RGBGetRValue(baseColor) * pulse;
+        int g = RGBGetGValue(baseColor) * pulse;
+        int b = RGBGetBValue(baseColor) * pulse;
         
-        printf("[Lightscape] TestEffect: Using user color with speed=%d, brightness=%d\n", speed, brightness);
+        LOG_TRACE("[Lightscape] TestEffect: Using user color with speed=%d", params.speed);
         return ToRGBColor(r, g, b);
     }
     
-    // Position-based colors with speed and brightness controls
+    // Position-based colors with speed control (brightness is applied by BaseEffect)
     int r = (pos.x * 20 + static_cast<int>(time * speedFactor * 50)) % 255;
     int g = (pos.y * 20 + static_cast<int>(time * speedFactor * 30)) % 255;
     int b = (pos.z * 20 + static_cast<int>(time * speedFactor * 70)) % 255;
     
-    // Apply brightness
-    float brightnessFactor = brightness / 100.0f;
-    r = static_cast<int>(r * brightnessFactor);
-    g = static_cast<int>(g * brightnessFactor);
-    b = static_cast<int>(b * brightnessFactor);
-    
     return ToRGBColor(r, g, b);
 }
 
-void TestEffect::StepEffect(std::vector<ControllerZone*> zones)
+void TestEffect::getColorsForPositions(const PositionBatch& positions, float time,
+                                       const EffectParameters& params, RGBColor* colors)
+{
+    const size_t count = positions.size();
+    if (count == 0) return;
+    
+    // Full-brightness colors; BaseEffect scales the frame once on output
+    float speedFactor = params.speed / 50.0f;
+    
+    // User color: the pulse does not depend on position, so compute it once and fill
+    if (params.hasColors()) {
+        RGBColor baseColor = params.colors[0];
+        float pulse = (sin(time * speedFactor * 3.0f) + 1.0f) / 2.0f;
+        
+        int r = RGBGetRValue(baseColor) * pulse;
+        int g = RGBGetGValue(baseColor) * pulse;
+        int b = RGBGetBValue(baseColor) * pulse;
+        
+        std::fill(colors, colors + count, ToRGBColor(r, g, b));
+        return;
+    }
+    
+    // Position-based colors: the time offsets are shared by every position
+    int offsetR = static_cast<int>(time * speedFactor * 50);
+    int offsetG = static_cast<int>(time * speedFactor * 30);
+    int offsetB = static_cast<int>(time * speedFactor * 70);
+    
+    const int* xs = positions.x.data();
+    const int* ys = positions.y.data();
+    const int* zs = positions.z.data();
+    
+    for (size_t i = 0; i < count; i++) {
+        int r = (xs[i] * 20 + offsetR) % 255;
+        int g = (ys[i] * 20 + offsetG) % 255;
+        int b = (zs[i] * 20 + offsetB) % 255;
+        colors[i] = ToRGBColor(r, g, b);
+    }
+}
+
+void TestEffect::StepEffect(ConstSpan<ControllerZone*> zones)
 {
     // Call the base class StepEffect to use our getColorForPosition method
     // This demonstrates using the existing spatial calculation for both interfaces
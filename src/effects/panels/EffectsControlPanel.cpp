@@ -8,6 +8,7 @@
 
 #include "effects/panels/EffectsControlPanel.h"
 #include "ui_EffectsControlPanel.h"
+#include "effects/panels/FrameStatsView.h"
 #include <QDebug>
 #include <QScrollArea>
 #include <QSlider>
@@ -21,6 +22,7 @@ EffectsControlPanel::EffectsControlPanel(QWidget *parent)
     , ui(new Ui::EffectsControlPanel)
     , _tabWidget(nullptr)
     , _currentEffect(nullptr)
+    , _statsView(nullptr)
 {
     ui->setupUi(this);
     setupUI();
@@ -62,6 +64,12 @@ void EffectsControlPanel::setupUI()
     // Add the tab widget to the main layout
     ui->mainLayout->addWidget(_tabWidget);
     
+    // Collapsed frame timing view below the effect tabs
+    if (!_statsView) {
+        _statsView = new FrameStatsView(this);
+        ui->mainLayout->addWidget(_statsView);
+    }
+    
     printf("[Lightscape] EffectsControlPanel: Created tabbed interface with tabs directly in panel\n");
 }
 
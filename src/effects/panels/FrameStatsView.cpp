@@ -0,0 +1,138 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| FrameStatsView.cpp                                        |
+|                                                           |
+| Small view of render thread frame timings                 |
+\*---------------------------------------------------------*/
+
+#include "effects/panels/FrameStatsView.h"
+#include "effects/EffectManager.h"
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+namespace Lightscape {
+
+FrameStatsView::FrameStatsView(QWidget* parent)
+    : QGroupBox("Frame statistics", parent)
+{
+    setCheckable(true);
+    setChecked(false);
+
+    QVBoxLayout* outerLayout = new QVBoxLayout(this);
+    outerLayout->setContentsMargins(6, 6, 6, 6);
+
+    _content = new QWidget(this);
+    QVBoxLayout* layout = new QVBoxLayout(_content);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(4);
+
+    QHBoxLayout* headerLayout = new QHBoxLayout();
+    _summaryLabel = new QLabel(_content);
+    _summaryLabel->setStyleSheet("color: #ccc;");
+    QPushButton* resetButton = new QPushButton("Reset", _content);
+    resetButton->setMaximumWidth(60);
+    headerLayout->addWidget(_summaryLabel, 1);
+    headerLayout->addWidget(resetButton);
+    layout->addLayout(headerLayout);
+
+    _table = new QTableWidget(0, 5, _content);
+    _table->setHorizontalHeaderLabels({"Stage", "p50 (us)", "p95 (us)", "p99 (us)", "max (us)"});
+    _table->verticalHeader()->setVisible(false);
+    _table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    _table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    _table->setSelectionMode(QAbstractItemView::NoSelection);
+    _table->setMinimumHeight(160);
+    layout->addWidget(_table);
+
+    _outputLabel = new QLabel(_content);
+    _outputLabel->setStyleSheet("color: #ccc;");
+    layout->addWidget(_outputLabel);
+
+    outerLayout->addWidget(_content);
+    _content->setVisible(false);
+
+    _refreshTimer = new QTimer(this);
+    _refreshTimer->setInterval(1000);
+
+    connect(_refreshTimer, &QTimer::timeout, this, &FrameStatsView::refresh);
+    connect(this, &QGroupBox::toggled, this, &FrameStatsView::onToggled);
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        EffectManager::getInstance().resetFrameStatistics();
+        refresh();
+    });
+}
+
+void FrameStatsView::onToggled(bool expanded)
+{
+    _content->setVisible(expanded);
+
+    if (expanded) {
+        refresh();
+        _refreshTimer->start();
+    } else {
+        _refreshTimer->stop();
+    }
+}
+
+void FrameStatsView::refresh()
+{
+    EffectManager& manager = EffectManager::getInstance();
+    FrameStatistics::Snapshot stats = manager.getFrameStatistics();
+
+    _summaryLabel->setText(QString("Frames: %1   Over budget (%2 ms): %3   Dropped: %4   Last frame sent/skipped: %5/%6")
+                           .arg(stats.frames)
+                           .arg(stats.budget / 1000.0, 0, 'f', 1)
+                           .arg(stats.overruns)
+                           .arg(stats.dropped)
+                           .arg(manager.getLastFrameSentCount())
+                           .arg(manager.getLastFrameSkippedCount()));
+
+    const int stageCount = static_cast<int>(FrameStage::Count);
+    _table->setRowCount(stageCount + stats.controllerFlush.size());
+
+    for (int i = 0; i < stageCount; i++) {
+        const TimingSummary& summary = stats.stages[i];
+        setRow(i, frameStageName(static_cast<FrameStage>(i)), summary.p50, summary.p95, summary.p99, summary.max);
+    }
+
+    int row = stageCount;
+    for (auto it = stats.controllerFlush.constBegin(); it != stats.controllerFlush.constEnd(); ++it, ++row) {
+        const TimingSummary& summary = it.value();
+        setRow(row, QString("  Flush controller %1").arg(it.key()), summary.p50, summary.p95, summary.p99, summary.max);
+    }
+
+    QStringList outputLines;
+    for (const DeviceOutputPool::ControllerStatistics& output : manager.getOutputStatistics()) {
+        outputLines.append(QString("Output controller %1: %2 fps, %3 ms/write, %4 of %5 frames dropped")
+                           .arg(output.deviceIndex)
+                           .arg(output.fps, 0, 'f', 1)
+                           .arg(output.writeMs, 0, 'f', 2)
+                           .arg(output.dropped)
+                           .arg(output.submitted));
+    }
+    _outputLabel->setText(outputLines.join("\n"));
+    _outputLabel->setVisible(!outputLines.isEmpty());
+}
+
+void FrameStatsView::setRow(int row, const QString& name, int p50, int p95, int p99, int max)
+{
+    const QString values[] = { name, QString::number(p50), QString::number(p95), QString::number(p99), QString::number(max) };
+
+    for (int column = 0; column < 5; column++) {
+        QTableWidgetItem* item = _table->item(row, column);
+        if (!item) {
+            item = new QTableWidgetItem();
+            if (column > 0) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            _table->setItem(row, column, item);
+        }
+        item->setText(values[column]);
+    }
+}
+
+} // namespace Lightscape
@@ -0,0 +1,138 @@
+#include "grid/SpatialField.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialField::SpatialField(const GridPosition& ref, int w, int h, int d,
+                           const QList<GridPosition>& assignedPositions)
+    : reference(ref)
+    , width(std::max(0, w))
+    , height(std::max(0, h))
+    , depth(std::max(0, d))
+    , max_distance(0.0f)
+{
+    const size_t cellCount = static_cast<size_t>(width) * height * depth;
+    distances.resize(cellCount);
+    normalized_distances.resize(cellCount);
+    for (std::vector<float>& plane : angles) {
+        plane.resize(cellCount);
+    }
+
+    // Fill every table in one pass over the grid
+    float gridMaxDistance = 0.0f;
+    size_t index = 0;
+    for (int z = 0; z < depth; z++) {
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++, index++) {
+                float dx = static_cast<float>(x - reference.x);
+                float dy = static_cast<float>(y - reference.y);
+                float dz = static_cast<float>(z - reference.z);
+
+                distances[index] = std::sqrt(dx*dx + dy*dy + dz*dz);
+                angles[PlaneXY][index] = std::atan2(dy, dx);
+                angles[PlaneXZ][index] = std::atan2(dz, dx);
+                angles[PlaneYZ][index] = std::atan2(dz, dy);
+
+                gridMaxDistance = std::max(gridMaxDistance, distances[index]);
+            }
+        }
+    }
+
+    // Normalize against the devices that are actually placed, if any
+    for (const GridPosition& pos : assignedPositions) {
+        max_distance = std::max(max_distance, GetDistance(pos));
+    }
+    if (max_distance <= 0.0f) {
+        max_distance = gridMaxDistance;
+    }
+
+    float scale = (max_distance > 0.0f) ? 1.0f / max_distance : 0.0f;
+    for (size_t i = 0; i < cellCount; i++) {
+        normalized_distances[i] = std::min(1.0f, distances[i] * scale);
+    }
+}
+
+int SpatialField::IndexOf(const GridPosition& pos) const
+{
+    if (pos.x < 0 || pos.x >= width ||
+        pos.y < 0 || pos.y >= height ||
+        pos.z < 0 || pos.z >= depth) {
+        return -1;
+    }
+
+    return (pos.z * height + pos.y) * width + pos.x;
+}
+
+float SpatialField::GetDistance(const GridPosition& pos) const
+{
+    int index = IndexOf(pos);
+    return (index >= 0) ? distances[index] : ComputeDistance(pos, reference);
+}
+
+float SpatialField::GetNormalizedDistance(const GridPosition& pos) const
+{
+    int index = IndexOf(pos);
+    if (index >= 0) return normalized_distances[index];
+
+    return (max_distance > 0.0f) ? std::min(1.0f, ComputeDistance(pos, reference) / max_distance) : 0.0f;
+}
+
+float SpatialField::GetAngle(const GridPosition& pos, Plane plane) const
+{
+    int index = IndexOf(pos);
+    return (index >= 0) ? angles[plane][index] : ComputeAngle(pos, reference, plane);
+}
+
+float SpatialField::ComputeDistance(const GridPosition& pos, const GridPosition& ref)
+{
+    float dx = static_cast<float>(pos.x - ref.x);
+    float dy = static_cast<float>(pos.y - ref.y);
+    float dz = static_cast<float>(pos.z - ref.z);
+    return std::sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+float SpatialField::ComputeAngle(const GridPosition& pos, const GridPosition& ref, Plane plane)
+{
+    float dx = static_cast<float>(pos.x - ref.x);
+    float dy = static_cast<float>(pos.y - ref.y);
+    float dz = static_cast<float>(pos.z - ref.z);
+
+    switch (plane) {
+        case PlaneXY: return std::atan2(dy, dx);
+        case PlaneXZ: return std::atan2(dz, dx);
+        case PlaneYZ: return std::atan2(dz, dy);
+    }
+    return 0.0f;
+}
+
+std::shared_ptr<const SpatialField> SpatialFieldCache::Get(const GridPosition& reference)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = fields.constFind(reference);
+    if (it != fields.constEnd()) {
+        return it.value();
+    }
+
+    auto field = std::make_shared<const SpatialField>(reference, width, height, depth, assigned_positions);
+    fields.insert(reference, field);
+    build_count++;
+    return field;
+}
+
+void SpatialFieldCache::Invalidate(int w, int h, int d, const QList<GridPosition>& assignedPositions)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Holders of the old fields keep them alive until they are done
+    fields.clear();
+    width = w;
+    height = h;
+    depth = d;
+    assigned_positions = assignedPositions;
+}
+
+int SpatialFieldCache::GetBuildCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return build_count;
+}
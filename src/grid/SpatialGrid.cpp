@@ -1,5 +1,6 @@
 #include "grid/SpatialGrid.h"
 #include <QDebug>
+#include <algorithm>
 
 const QString SpatialGrid::USER_POSITION_STYLE = 
     "QPushButton { background-color: #4CAF50; color: white; border: 2px solid #45a049; border-radius: 4px; }"
@@ -19,11 +20,29 @@ SpatialGrid::SpatialGrid(QObject* parent)
     , selected_button(nullptr)
     , requires_user_position(false)
 {
+    cell_spans.resize(static_cast<size_t>(dimensions.width) * dimensions.height * dimensions.depth);
+    
+    // Fields are keyed by reference point and normalized to the assigned cells, so
+    // only a cell gaining its first or losing its last assignment makes them stale;
+    // color edits and extra assignments in an occupied cell leave them alone
+    connect(this, &SpatialGrid::assignmentsChanged, this, [this]() { if (spatial_layout_dirty) InvalidateSpatialFields(); });
+    connect(this, &SpatialGrid::assignmentsCommitted, this, [this]() { if (spatial_layout_dirty) InvalidateSpatialFields(); });
+    connect(this, &SpatialGrid::gridUpdated, this, [this]() { InvalidateSpatialFields(); });
+    
+    InvalidateSpatialFields();
 }
 
 void SpatialGrid::SetDimensions(const GridDimensions& dims)
 {
+    AssignmentBatch batch(this);
+    QList<GridPosition> moved = ResizeAssignmentStorage(dims);
     dimensions = dims;
+    RebuildDeviceIndex();
+    
+    // Cells that were parked or brought back read differently now
+    for (const GridPosition& pos : moved) {
+        NotifyAssignmentsChanged(pos);
+    }
     emit gridUpdated();
 }
 
@@ -177,42 +196,89 @@ void SpatialGrid::ClearSelection()
 bool SpatialGrid::HasAssignments(const GridPosition& pos) const
 {
     if (!ValidatePosition(pos)) return false;
-    return assignments.contains(pos) && !assignments[pos].isEmpty();
+    return cell_spans[CellIndex(pos)].count > 0;
 }
 
 QList<DeviceAssignment> SpatialGrid::GetAssignments(const GridPosition& pos) const
 {
-    if (!ValidatePosition(pos)) return QList<DeviceAssignment>();
-    return assignments.value(pos);
+    Lightscape::ConstSpan<DeviceAssignment> span = GetAssignmentSpan(pos);
+    
+    QList<DeviceAssignment> result;
+    result.reserve(static_cast<int>(span.size()));
+    for (const DeviceAssignment& assignment : span) {
+        result.append(assignment);
+    }
+    return result;
+}
+
+Lightscape::ConstSpan<DeviceAssignment> SpatialGrid::GetAssignmentSpan(const GridPosition& pos) const
+{
+    if (!ValidatePosition(pos)) return Lightscape::ConstSpan<DeviceAssignment>();
+    
+    const CellSpan& span = cell_spans[CellIndex(pos)];
+    return Lightscape::ConstSpan<DeviceAssignment>(assignment_pool.data() + span.offset, span.count);
+}
+
+QList<GridPosition> SpatialGrid::GetAssignedPositions() const
+{
+    QList<GridPosition> positions;
+    positions.reserve(assigned_cells);
+    ForEachAssignedCell([&positions](const GridPosition& pos, Lightscape::ConstSpan<DeviceAssignment>) {
+        positions.append(pos);
+    });
+    return positions;
 }
 
 void SpatialGrid::AddAssignment(const GridPosition& pos, const DeviceAssignment& assignment)
 {
     if (!ValidatePosition(pos)) return;
     
-    if (!assignments.contains(pos)) {
-        assignments[pos] = QList<DeviceAssignment>();
+    CellSpan& span = cell_spans[CellIndex(pos)];
+    
+    if (span.count == 0) {
+        span.offset = static_cast<uint32_t>(assignment_pool.size());
+        assigned_cells++;
+        spatial_layout_dirty = true;
+    } else if (span.offset + span.count != assignment_pool.size()) {
+        // The run can't grow in place: move it to the end of the pool, leaving a hole
+        uint32_t newOffset = static_cast<uint32_t>(assignment_pool.size());
+        for (uint32_t i = 0; i < span.count; i++) {
+            assignment_pool.push_back(assignment_pool[span.offset + i]);
+        }
+        pool_garbage += span.count;
+        span.offset = newOffset;
     }
-    assignments[pos].append(assignment);
     
-    UpdateButtonStyle(GetButtonAtPosition(pos), pos);
-    emit assignmentsChanged(pos);
+    assignment_pool.push_back(assignment);
+    span.count++;
+    IndexAssignment(assignment, pos);
+    
+    if (pool_garbage > assignment_pool.size() / 2) {
+        CompactAssignments();
+    }
+    
+    NotifyAssignmentsChanged(pos);
 }
 
 void SpatialGrid::RemoveAssignment(const GridPosition& pos, int index)
 {
     if (!ValidatePosition(pos)) return;
-    if (!assignments.contains(pos)) return;
     
-    auto& assignmentList = assignments[pos];
-    if (index >= 0 && index < assignmentList.size()) {
-        assignmentList.removeAt(index);
-        if (assignmentList.isEmpty()) {
-            assignments.remove(pos);
+    CellSpan& span = cell_spans[CellIndex(pos)];
+    if (index >= 0 && static_cast<uint32_t>(index) < span.count) {
+        auto runBegin = assignment_pool.begin() + span.offset;
+        UnindexAssignment(*(runBegin + index), pos);
+        std::move(runBegin + index + 1, runBegin + span.count, runBegin + index);
+        span.count--;
+        pool_garbage++;
+        
+        if (span.count == 0) {
+            span.offset = 0;
+            assigned_cells--;
+            spatial_layout_dirty = true;
         }
         
-        UpdateButtonStyle(GetButtonAtPosition(pos), pos);
-        emit assignmentsChanged(pos);
+        NotifyAssignmentsChanged(pos);
     }
 }
 
@@ -220,34 +286,95 @@ void SpatialGrid::ClearAssignments(const GridPosition& pos)
 {
     if (!ValidatePosition(pos)) return;
     
-    if (assignments.contains(pos)) {
-        assignments.remove(pos);
-        UpdateButtonStyle(GetButtonAtPosition(pos), pos);
-        emit assignmentsChanged(pos);
+    CellSpan& span = cell_spans[CellIndex(pos)];
+    if (span.count > 0) {
+        for (uint32_t i = 0; i < span.count; i++) {
+            UnindexAssignment(assignment_pool[span.offset + i], pos);
+        }
+        pool_garbage += span.count;
+        span = CellSpan();
+        assigned_cells--;
+        spatial_layout_dirty = true;
+        
+        NotifyAssignmentsChanged(pos);
     }
 }
 
 void SpatialGrid::ClearAllAssignments()
 {
-    QSet<GridPosition> positions = QSet<GridPosition>::fromList(assignments.keys());
-    assignments.clear();
+    AssignmentBatch batch(this);
+    QList<GridPosition> positions = GetAssignedPositions();
+    
+    std::fill(cell_spans.begin(), cell_spans.end(), CellSpan());
+    assignment_pool.clear();
+    pool_garbage = 0;
+    assigned_cells = 0;
+    device_positions.clear();
+    parked_cells.clear();
+    spatial_layout_dirty = !positions.isEmpty();
+    
+    for (const GridPosition& pos : positions) {
+        NotifyAssignmentsChanged(pos);
+    }
+}
+
+void SpatialGrid::BeginAssignmentBatch()
+{
+    batch_depth++;
+}
+
+void SpatialGrid::CommitAssignmentBatch()
+{
+    if (batch_depth == 0) return;
+    if (--batch_depth > 0) return;
+    
+    if (batch_positions.isEmpty()) return;
+    
+    QSet<GridPosition> positions;
+    positions.swap(batch_positions);
     
     for (const GridPosition& pos : positions) {
         UpdateButtonStyle(GetButtonAtPosition(pos), pos);
-        emit assignmentsChanged(pos);
     }
+    emit assignmentsCommitted(positions);
+}
+
+void SpatialGrid::NotifyAssignmentsChanged(const GridPosition& pos)
+{
+    if (batch_depth > 0) {
+        batch_positions.insert(pos);
+        return;
+    }
+    
+    UpdateButtonStyle(GetButtonAtPosition(pos), pos);
+    emit assignmentsChanged(pos);
 }
 
 bool SpatialGrid::UpdateAssignmentColor(const GridPosition& pos, int index, const RGBColor& color)
 {
     if (!ValidatePosition(pos)) return false;
-    if (!assignments.contains(pos)) return false;
     
-    auto& assignmentList = assignments[pos];
-    if (index >= assignmentList.size()) return false;
+    const CellSpan& span = cell_spans[CellIndex(pos)];
+    if (index < 0 || static_cast<uint32_t>(index) >= span.count) return false;
     
-    assignmentList[index].color = color;
-    emit assignmentsChanged(pos);
+    assignment_pool[span.offset + index].color = color;
+    NotifyAssignmentsChanged(pos);
+    return true;
+}
+
+bool SpatialGrid::UpdateAssignment(const GridPosition& pos, int index, const DeviceAssignment& assignment)
+{
+    if (!ValidatePosition(pos)) return false;
+    
+    const CellSpan& span = cell_spans[CellIndex(pos)];
+    if (index < 0 || static_cast<uint32_t>(index) >= span.count) return false;
+    
+    DeviceAssignment& slot = assignment_pool[span.offset + index];
+    UnindexAssignment(slot, pos);
+    slot = assignment;
+    IndexAssignment(slot, pos);
+    
+    NotifyAssignmentsChanged(pos);
     return true;
 }
 
@@ -367,22 +494,142 @@ void SpatialGrid::UpdateButtonStyle(QPushButton* button, const GridPosition& pos
 
 std::optional<GridPosition> SpatialGrid::GetDevicePosition(const Lightscape::DeviceInfo& device) const
 {
-    // Iterate through all positions with assignments
-    for (auto it = assignments.constBegin(); it != assignments.constEnd(); ++it) {
-        const GridPosition& pos = it.key();
-        const QList<DeviceAssignment>& assignmentList = it.value();
+    // First position in x, y, z order, same as the old full-grid scan
+    QList<GridPosition> positions = GetDevicePositions(device);
+    if (positions.isEmpty()) {
+        return std::nullopt;
+    }
+    
+    return *std::min_element(positions.begin(), positions.end());
+}
+
+QList<GridPosition> SpatialGrid::GetDevicePositions(const Lightscape::DeviceInfo& device) const
+{
+    DeviceAssignment key(static_cast<unsigned int>(device.index), device.type, device.zoneIndex, device.ledIndex);
+    return device_positions.value(key);
+}
+
+std::shared_ptr<const SpatialField> SpatialGrid::GetSpatialField(const GridPosition& reference) const
+{
+    return field_cache.Get(reference);
+}
+
+void SpatialGrid::InvalidateSpatialFields()
+{
+    spatial_layout_dirty = false;
+    field_cache.Invalidate(dimensions.width, dimensions.height, dimensions.depth, GetAssignedPositions());
+}
+
+int SpatialGrid::CellIndex(const GridPosition& pos) const
+{
+    return pos.x + pos.y * dimensions.width + pos.z * dimensions.width * dimensions.height;
+}
+
+GridPosition SpatialGrid::CellPosition(int index) const
+{
+    int layerSize = dimensions.width * dimensions.height;
+    return GridPosition(index % dimensions.width, (index % layerSize) / dimensions.width, index / layerSize);
+}
+
+void SpatialGrid::CompactAssignments()
+{
+    // Rewrite the pool with every run in cell order and no holes
+    std::vector<DeviceAssignment> compacted;
+    compacted.reserve(assignment_pool.size() - pool_garbage);
+    
+    for (CellSpan& span : cell_spans) {
+        if (span.count == 0) continue;
         
-        // Check each assignment at this position
-        for (const DeviceAssignment& assignment : assignmentList) {
-            if (assignment.device_index == device.index && 
-                assignment.device_type == device.type && 
-                assignment.zone_index == device.zoneIndex && 
-                assignment.led_index == device.ledIndex) {
-                return pos;
+        uint32_t newOffset = static_cast<uint32_t>(compacted.size());
+        compacted.insert(compacted.end(),
+                         assignment_pool.begin() + span.offset,
+                         assignment_pool.begin() + span.offset + span.count);
+        span.offset = newOffset;
+    }
+    
+    assignment_pool.swap(compacted);
+    pool_garbage = 0;
+}
+
+QList<GridPosition> SpatialGrid::ResizeAssignmentStorage(const GridDimensions& newDimensions)
+{
+    // Lay the cells out in the new order; cells outside the new grid are parked,
+    // not dropped, so growing the grid again brings them back
+    std::vector<CellSpan> spans(static_cast<size_t>(newDimensions.width) * newDimensions.height * newDimensions.depth);
+    std::vector<DeviceAssignment> pool;
+    pool.reserve(assignment_pool.size() - pool_garbage);
+    int cells = 0;
+    QList<GridPosition> moved;
+    
+    for (int z = 0; z < newDimensions.depth; z++) {
+        for (int y = 0; y < newDimensions.height; y++) {
+            for (int x = 0; x < newDimensions.width; x++) {
+                GridPosition pos(x, y, z);
+                CellSpan& span = spans[x + y * newDimensions.width + z * newDimensions.width * newDimensions.height];
+                span.offset = static_cast<uint32_t>(pool.size());
+                
+                if (ValidatePosition(pos)) {
+                    const CellSpan& old = cell_spans[CellIndex(pos)];
+                    pool.insert(pool.end(), assignment_pool.begin() + old.offset, assignment_pool.begin() + old.offset + old.count);
+                    span.count = old.count;
+                } else {
+                    auto parked = parked_cells.find(pos);
+                    if (parked == parked_cells.end()) continue;
+                    pool.insert(pool.end(), parked->begin(), parked->end());
+                    span.count = static_cast<uint32_t>(parked->size());
+                    parked_cells.erase(parked);
+                    moved.append(pos);
+                }
+                
+                if (span.count == 0) {
+                    span.offset = 0;
+                } else {
+                    cells++;
+                }
             }
         }
     }
     
-    // Device not found in any position
-    return std::nullopt;
-}
\ No newline at end of file
+    for (size_t i = 0; i < cell_spans.size(); i++) {
+        const CellSpan& old = cell_spans[i];
+        GridPosition pos = CellPosition(static_cast<int>(i));
+        if (old.count == 0 || (pos.x < newDimensions.width && pos.y < newDimensions.height && pos.z < newDimensions.depth)) {
+            continue;
+        }
+        parked_cells[pos].assign(assignment_pool.begin() + old.offset, assignment_pool.begin() + old.offset + old.count);
+        moved.append(pos);
+    }
+    
+    cell_spans.swap(spans);
+    assignment_pool.swap(pool);
+    pool_garbage = 0;
+    assigned_cells = cells;
+    return moved;
+}
+
+void SpatialGrid::IndexAssignment(const DeviceAssignment& assignment, const GridPosition& pos)
+{
+    device_positions[assignment].append(pos);
+}
+
+void SpatialGrid::UnindexAssignment(const DeviceAssignment& assignment, const GridPosition& pos)
+{
+    auto it = device_positions.find(assignment);
+    if (it == device_positions.end()) return;
+    
+    // Drop one occurrence; the same device may be assigned to a cell more than once
+    it->removeOne(pos);
+    if (it->isEmpty()) {
+        device_positions.erase(it);
+    }
+}
+
+void SpatialGrid::RebuildDeviceIndex()
+{
+    device_positions.clear();
+    ForEachAssignedCell([this](const GridPosition& pos, Lightscape::ConstSpan<DeviceAssignment> span) {
+        for (const DeviceAssignment& assignment : span) {
+            IndexAssignment(assignment, pos);
+        }
+    });
+}
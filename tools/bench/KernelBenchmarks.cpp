@@ -0,0 +1,171 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| KernelBenchmarks.cpp                                      |
+|                                                           |
+| Micro-benchmarks for the hot per-frame kernels            |
+\*---------------------------------------------------------*/
+
+#include "KernelBenchmarks.h"
+#include <QImage>
+#include <QPainter>
+#include <QSet>
+#include <vector>
+#include "effects/BaseEffect.h"
+#include "effects/ColorScale.h"
+#include "effects/PositionBatch.h"
+#include "effects/PreviewRenderer3D.h"
+#include "grid/SpatialGrid.h"
+
+namespace Lightscape {
+
+namespace {
+
+// Results are folded in here so the compiler cannot drop the measured work
+volatile quint64 benchSink = 0;
+
+// Exposes the protected brightness helper; never rendered
+class BrightnessProbe : public BaseEffect
+{
+public:
+    RGBColor getColorForPosition(const GridPosition&, float) override { return 0; }
+    using BaseEffect::applyBrightness;
+};
+
+template<typename Body>
+KernelResult measure(const QString& name, quint64 itemsPerIteration, std::chrono::milliseconds minTime, Body body)
+{
+    using Clock = std::chrono::steady_clock;
+
+    benchSink = benchSink + body();
+
+    quint64 iterations = 0;
+    Clock::time_point start = Clock::now();
+    Clock::duration elapsed = Clock::duration::zero();
+    while (elapsed < minTime) {
+        benchSink = benchSink + body();
+        iterations++;
+        elapsed = Clock::now() - start;
+    }
+
+    KernelResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.itemsPerIteration = itemsPerIteration;
+    result.nanosecondsPerIteration = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    return result;
+}
+
+} // namespace
+
+QList<KernelResult> runKernelBenchmarks(SpatialGrid& grid, ConstSpan<DeviceInfo> devices,
+                                        BaseEffect* effect, std::chrono::milliseconds minTime)
+{
+    QList<KernelResult> results;
+
+    const GridDimensions dims = grid.GetDimensions();
+    PositionBatch cells;
+    for (int z = 0; z < dims.depth; z++) {
+        for (int y = 0; y < dims.height; y++) {
+            for (int x = 0; x < dims.width; x++) {
+                cells.append(GridPosition(x, y, z));
+            }
+        }
+    }
+    const quint64 cellCount = cells.size();
+    std::vector<RGBColor> colors(cellCount);
+    const float time = 1.25f;
+
+    // Effect color evaluation over the full grid
+    results.append(measure("BaseEffect::getColorForPosition/grid", cellCount, minTime, [&]() {
+        quint64 sum = 0;
+        for (size_t i = 0; i < cells.size(); i++) {
+            sum += effect->getColorForPosition(cells.at(i), time);
+        }
+        return sum;
+    }));
+
+    const EffectParameters params = effect->parameters();
+    results.append(measure("BaseEffect::getColorsForPositions/grid", cellCount, minTime, [&]() {
+        effect->getColorsForPositions(cells, time, params, colors.data());
+        return static_cast<quint64>(colors[cellCount / 2]);
+    }));
+
+    // Brightness scaling of a full frame
+    BrightnessProbe probe;
+    std::vector<RGBColor> frame(devices.size());
+    for (size_t i = 0; i < frame.size(); i++) {
+        frame[i] = ToRGBColor(i & 0xFF, (i * 7) & 0xFF, (i * 13) & 0xFF);
+    }
+    results.append(measure("BaseEffect::applyBrightness/frame", frame.size(), minTime, [&]() {
+        quint64 sum = 0;
+        for (RGBColor color : frame) {
+            sum += probe.applyBrightness(color, 0.75f);
+        }
+        return sum;
+    }));
+
+    std::vector<RGBColor> scaled(frame.size());
+    results.append(measure("scaleColors/frame", frame.size(), minTime, [&]() {
+        scaleColors(frame.data(), scaled.data(), frame.size(), 75);
+        return static_cast<quint64>(scaled[frame.size() / 2]);
+    }));
+
+    // Grid assignment lookups
+    results.append(measure("SpatialGrid::HasAssignments/grid", cellCount, minTime, [&]() {
+        quint64 count = 0;
+        for (size_t i = 0; i < cells.size(); i++) {
+            count += grid.HasAssignments(cells.at(i)) ? 1 : 0;
+        }
+        return count;
+    }));
+
+    results.append(measure("SpatialGrid::GetAssignments/grid", cellCount, minTime, [&]() {
+        quint64 count = 0;
+        for (size_t i = 0; i < cells.size(); i++) {
+            count += grid.GetAssignments(cells.at(i)).size();
+        }
+        return count;
+    }));
+
+    results.append(measure("SpatialGrid::GetAssignmentSpan/grid", cellCount, minTime, [&]() {
+        quint64 count = 0;
+        for (size_t i = 0; i < cells.size(); i++) {
+            count += grid.GetAssignmentSpan(cells.at(i)).size();
+        }
+        return count;
+    }));
+
+    results.append(measure("SpatialGrid::ForEachAssignedCell/grid", cellCount, minTime, [&]() {
+        quint64 count = 0;
+        grid.ForEachAssignedCell([&](const GridPosition&, ConstSpan<DeviceAssignment> span) {
+            count += span.size();
+        });
+        return count;
+    }));
+
+    results.append(measure("SpatialGrid::GetDevicePosition/devices", devices.size(), minTime, [&]() {
+        quint64 count = 0;
+        for (const DeviceInfo& device : devices) {
+            count += grid.GetDevicePosition(device).has_value() ? 1 : 0;
+        }
+        return count;
+    }));
+
+    // Preview repaint into an offscreen image
+    PreviewRenderer3D renderer;
+    QImage image(800, 600, QImage::Format_ARGB32_Premultiplied);
+    const QSet<GridPosition> noDevices;
+    results.append(measure("PreviewRenderer3D::draw/800x600", cellCount, minTime, [&]() {
+        image.fill(Qt::black);
+        QPainter painter(&image);
+        renderer.draw(painter, image.width(), image.height(), &grid, effect,
+                      30.0f, 45.0f, 0.0f, 1.0f, QPoint(0, 0), true, false, noDevices);
+        painter.end();
+        return static_cast<quint64>(image.pixel(image.width() / 2, image.height() / 2));
+    }));
+
+    return results;
+}
+
+} // namespace Lightscape
@@ -0,0 +1,43 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| KernelBenchmarks.h                                        |
+|                                                           |
+| Micro-benchmarks for the hot per-frame kernels            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <chrono>
+#include "core/Span.h"
+#include "core/Types.h"
+
+class SpatialGrid;
+
+namespace Lightscape {
+
+class BaseEffect;
+
+struct KernelResult {
+    QString name;
+    quint64 iterations = 0;
+    quint64 itemsPerIteration = 0;
+    double nanosecondsPerIteration = 0.0;
+
+    double itemsPerSecond() const
+    {
+        return nanosecondsPerIteration > 0.0 ? itemsPerIteration * 1e9 / nanosecondsPerIteration : 0.0;
+    }
+};
+
+/**
+ * Times each kernel in a loop until minTime has passed (after one warm-up
+ * call) and reports the mean cost per iteration. 'effect' must already be
+ * initialized against 'grid'.
+ */
+QList<KernelResult> runKernelBenchmarks(SpatialGrid& grid, ConstSpan<DeviceInfo> devices,
+                                        BaseEffect* effect, std::chrono::milliseconds minTime);
+
+} // namespace Lightscape
@@ -0,0 +1,111 @@
+#-----------------------------------------------------------------------------------------------#
+# Lightscape Headless Benchmark QMake Project                                                   #
+#-----------------------------------------------------------------------------------------------#
+
+# Console app that renders the registered effects against stand-in controllers at a fixed
+# timestep and reports throughput plus an output checksum. Build it next to the plugin:
+#   qmake tools/bench/LightscapeBench.pro && make
+#   ./LightscapeBench --frames 600 --golden golden.txt --kernels --json results.json
+
+#-----------------------------------------------------------------------------------------------#
+# Qt Configuration                                                                              #
+#-----------------------------------------------------------------------------------------------#
+QT +=                                                                                           \
+    core                                                                                        \
+    gui                                                                                         \
+    widgets                                                                                     \
+
+TEMPLATE = app
+TARGET = LightscapeBench
+
+#-----------------------------------------------------------------------------------------------#
+# Build Configuration                                                                           #
+#-----------------------------------------------------------------------------------------------#
+CONFIG +=                                                                                       \
+    console                                                                                     \
+    c++17                                                                                       \
+    silent                                                                                      \
+
+CONFIG -= app_bundle
+CONFIG(debug, debug|release):DEFINES += LIGHTSCAPE_TRACE
+
+ROOT = $$PWD/../..
+
+#-----------------------------------------------------------------------------------------------#
+# Include Paths                                                                                 #
+#-----------------------------------------------------------------------------------------------#
+INCLUDEPATH +=                                                                                  \
+    .                                                                                           \
+    $$ROOT/include                                                                              \
+    $$ROOT/OpenRGB                                                                              \
+    $$ROOT/OpenRGB/RGBController                                                                \
+    $$ROOT/OpenRGB/dependencies/json                                                            \
+
+#-----------------------------------------------------------------------------------------------#
+# Headers                                                                                       #
+#-----------------------------------------------------------------------------------------------#
+HEADERS +=                                                                                      \
+    KernelBenchmarks.h                                                                          \
+    $$ROOT/include/core/LoggingManager.h                                                        \
+    $$ROOT/include/core/SeqLock.h                                                               \
+    $$ROOT/include/core/Span.h                                                                  \
+    $$ROOT/include/core/FrameArena.h                                                            \
+    $$ROOT/include/core/Types.h                                                                 \
+    $$ROOT/include/devices/ControllerSource.h                                                   \
+    $$ROOT/include/devices/DeviceHandle.h                                                       \
+    $$ROOT/include/devices/DeviceManager.h                                                      \
+    $$ROOT/include/devices/DeviceNameIndex.h                                                    \
+    $$ROOT/include/devices/DeviceNotifier.h                                                     \
+    $$ROOT/include/devices/DeviceOutputPool.h                                                   \
+    $$ROOT/include/devices/MockControllerBackend.h                                              \
+    $$ROOT/include/devices/NonRGBDevice.h                                                       \
+    $$ROOT/include/effects/BaseEffect.h                                                         \
+    $$ROOT/include/effects/ColorScale.h                                                         \
+    $$ROOT/include/effects/EffectInfo.h                                                         \
+    $$ROOT/include/effects/EffectList.h                                                         \
+    $$ROOT/include/effects/EffectParameters.h                                                   \
+    $$ROOT/include/effects/EffectRegistry.h                                                     \
+    $$ROOT/include/effects/FrameCompositor.h                                                    \
+    $$ROOT/include/effects/FrameStatistics.h                                                    \
+    $$ROOT/include/effects/LayerBlend.h                                                         \
+    $$ROOT/include/effects/PositionBatch.h                                                      \
+    $$ROOT/include/effects/PreviewRenderer3D.h                                                  \
+    $$ROOT/include/effects/SpatialControllerZone.h                                              \
+    $$ROOT/include/effects/TestEffect/TestEffect.h                                              \
+    $$ROOT/include/grid/GridTypes.h                                                             \
+    $$ROOT/include/grid/SpatialField.h                                                          \
+    $$ROOT/include/grid/SpatialGrid.h                                                           \
+
+#-----------------------------------------------------------------------------------------------#
+# Sources                                                                                       #
+#-----------------------------------------------------------------------------------------------#
+SOURCES +=                                                                                      \
+    main.cpp                                                                                    \
+    KernelBenchmarks.cpp                                                                        \
+    $$ROOT/src/core/LoggingManager.cpp                                                          \
+    $$ROOT/src/core/FrameArena.cpp                                                              \
+    $$ROOT/src/devices/DeviceManager.cpp                                                        \
+    $$ROOT/src/devices/DeviceNameIndex.cpp                                                      \
+    $$ROOT/src/devices/DeviceNotifier.cpp                                                       \
+    $$ROOT/src/devices/DeviceOutputPool.cpp                                                     \
+    $$ROOT/src/devices/MockControllerBackend.cpp                                                \
+    $$ROOT/src/devices/NonRGBDevice.cpp                                                         \
+    $$ROOT/src/effects/BaseEffect.cpp                                                           \
+    $$ROOT/src/effects/ColorScale.cpp                                                           \
+    $$ROOT/src/effects/EffectList.cpp                                                           \
+    $$ROOT/src/effects/EffectRegistry.cpp                                                       \
+    $$ROOT/src/effects/FrameCompositor.cpp                                                      \
+    $$ROOT/src/effects/FrameStatistics.cpp                                                      \
+    $$ROOT/src/effects/LayerBlend.cpp                                                           \
+    $$ROOT/src/effects/PreviewRenderer3D.cpp                                                    \
+    $$ROOT/src/effects/SpatialControllerZone.cpp                                                \
+    $$ROOT/src/effects/TestEffect/TestEffect.cpp                                                \
+    $$ROOT/src/grid/SpatialField.cpp                                                            \
+    $$ROOT/src/grid/SpatialGrid.cpp                                                             \
+    $$ROOT/OpenRGB/RGBController/RGBController.cpp                                              \
+
+#-----------------------------------------------------------------------------------------------#
+# Build Directories                                                                             #
+#-----------------------------------------------------------------------------------------------#
+OBJECTS_DIR = build/obj
+MOC_DIR = build/moc
@@ -0,0 +1,641 @@
+/*---------------------------------------------------------*\
+| Lightscape Plugin for OpenRGB                             |
+|                                                           |
+| main.cpp                                                  |
+|                                                           |
+| Headless deterministic render harness and benchmark       |
+\*---------------------------------------------------------*/
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QStringList>
+#include <QTextStream>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "KernelBenchmarks.h"
+#include "devices/DeviceManager.h"
+#include "devices/MockControllerBackend.h"
+#include "effects/BaseEffect.h"
+#include "effects/EffectRegistry.h"
+#include "effects/FrameCompositor.h"
+#include "grid/SpatialGrid.h"
+
+using namespace Lightscape;
+
+namespace {
+
+// --count-allocations: every operator new while this is set, on any thread
+std::atomic<bool> countingAllocations{false};
+std::atomic<quint64> allocationCount{0};
+
+} // namespace
+
+// Replaces the global allocator for the whole process, so allocations made by
+// Qt and by the output threads are counted too. new[] and nothrow new forward
+// here; over-aligned new isn't replaced and nothing on the frame path uses it.
+void* operator new(std::size_t size)
+{
+    if (countingAllocations.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* memory = std::malloc(size > 0 ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace {
+
+// Frames that may still allocate while buffers and caches size themselves
+// (frame arenas, output worker slots, per-controller state)
+constexpr int AllocationWarmupFrames = 4;
+
+struct BenchOptions {
+    QStringList effectIds;
+    int frames = 600;
+    double timestep = 1.0 / 60.0;
+    GridDimensions grid{16, 8, 4};
+    int controllers = 8;
+    int zones = 4;
+    int ledsPerZone = 32;
+    QString deviceSpec;                 // overrides controllers/zones/leds
+    std::vector<MockControllerSpec> deviceSpecs;
+    double latencyMs = -1.0;            // < 0 keeps the spec's own latency
+    double jitterMs = 0.0;
+    bool asyncOutput = false;
+    bool countAllocations = false;
+    LayerSettings layer;                // how the effect's layer is blended onto the base
+    bool checkStatic = false;           // frozen time, every frame must match the first
+    QString goldenFile;
+    QString writeGoldenFile;
+    QString jsonFile;
+    bool kernels = false;
+    int kernelMinTime = 200;
+
+    // Everything that changes the output, used to key golden checksums.
+    // Device latency doesn't; async output only checksums the last frame.
+    QString configKey() const
+    {
+        QString key = QString("f%1-dt%2-g%3x%4x%5")
+            .arg(frames).arg(timestep, 0, 'g', 6)
+            .arg(grid.width).arg(grid.height).arg(grid.depth);
+
+        if (deviceSpecs.empty()) {
+            key += QString("-c%1x%2x%3").arg(controllers).arg(zones).arg(ledsPerZone);
+        } else {
+            key += "-d";
+            for (const MockControllerSpec& spec : deviceSpecs) {
+                switch (spec.topology) {
+                    case MockTopology::Linear: key += QString("l%1x%2").arg(spec.zones).arg(spec.width); break;
+                    case MockTopology::Matrix: key += QString("m%1x%2").arg(spec.width).arg(spec.height); break;
+                    case MockTopology::Single: key += QString("s%1").arg(spec.zones); break;
+                }
+            }
+        }
+
+        if (!(layer == LayerSettings())) key += QString("-b%1%2").arg(blendModeToString(layer.mode)).arg(layer.opacity);
+        if (checkStatic) key += "-static";
+        if (asyncOutput) key += "-async";
+        return key;
+    }
+
+    std::vector<MockControllerSpec> controllerSpecs() const
+    {
+        std::vector<MockControllerSpec> specs = deviceSpecs;
+        if (specs.empty()) {
+            MockControllerSpec spec;
+            spec.zones = zones;
+            spec.width = ledsPerZone;
+            specs.assign(controllers, spec);
+        }
+
+        if (latencyMs >= 0.0) {
+            for (MockControllerSpec& spec : specs) {
+                spec.latency = std::chrono::microseconds(static_cast<long long>(latencyMs * 1000.0));
+                spec.jitter = std::chrono::microseconds(static_cast<long long>(jitterMs * 1000.0));
+            }
+        }
+        return specs;
+    }
+};
+
+struct BenchResult {
+    QString effectId;
+    int frames = 0;
+    size_t ledsPerFrame = 0;
+    double seconds = 0.0;
+    quint64 checksum = 0;
+    quint64 sentUpdates = 0;
+    quint64 skippedUpdates = 0;
+    quint64 droppedFrames = 0;      // async output only
+    quint64 deviceWrites = 0;
+    double meanWriteMs = 0.0;
+    double maxWriteMs = 0.0;
+    quint64 allocations = 0;        // after the warm-up frames, with --count-allocations
+    int firstChangedFrame = -1;     // --static: first frame that differs from frame 1
+
+    double framesPerSecond() const { return seconds > 0.0 ? frames / seconds : 0.0; }
+    double ledsPerSecond() const { return framesPerSecond() * ledsPerFrame; }
+};
+
+constexpr quint64 FnvOffset = 14695981039346656037ULL;
+constexpr quint64 FnvPrime  = 1099511628211ULL;
+
+// FNV-1a over the bytes of every color, in controller order
+quint64 hashColors(quint64 hash, const std::vector<RGBColor>& colors)
+{
+    for (RGBColor color : colors) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash ^= (color >> shift) & 0xFF;
+            hash *= FnvPrime;
+        }
+    }
+    return hash;
+}
+
+bool parseDimensions(const QString& text, GridDimensions& dims)
+{
+    QStringList parts = text.split('x');
+    if (parts.size() != 3) return false;
+
+    bool ok[3];
+    GridDimensions parsed(parts[0].toInt(&ok[0]), parts[1].toInt(&ok[1]), parts[2].toInt(&ok[2]));
+    if (!ok[0] || !ok[1] || !ok[2] || parsed.width <= 0 || parsed.height <= 0 || parsed.depth <= 0) {
+        return false;
+    }
+
+    dims = parsed;
+    return true;
+}
+
+bool parseArguments(const QCoreApplication& app, BenchOptions& options)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders Lightscape effects headless at a fixed timestep and reports throughput.");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "effect", "Effect id to run, may be repeated (default: all registered).", "id" },
+        { "frames", "Frames to render per effect (default 600).", "n" },
+        { "timestep", "Fixed frame timestep in seconds (default 1/60).", "s" },
+        { "grid", "Grid size as WxHxD (default 16x8x4).", "dims" },
+        { "controllers", "Stand-in controller count (default 8).", "n" },
+        { "zones", "Zones per controller (default 4).", "n" },
+        { "leds", "LEDs per zone (default 32).", "n" },
+        { "devices", "Mock controller specs instead of the three options above, "
+                     "e.g. \"6*linear:4x32,matrix:22x6@8~4,single:4@30\".", "specs" },
+        { "latency", "Simulated time per controller update in ms, for every controller.", "ms" },
+        { "jitter", "Up to this much extra random time per update in ms (with --latency).", "ms" },
+        { "async-output", "Write controllers on the per-controller output threads, like the plugin." },
+        { "count-allocations", "Count heap allocations in the frame loop after a few warm-up frames, "
+                               "fail if there are any." },
+        { "blend", "Blend mode of the effect's layer: normal, add, multiply, screen, max or alpha.", "mode" },
+        { "opacity", "Opacity of the effect's layer, 0-100 (default 100).", "percent" },
+        { "static", "Freeze effect time and fail unless every frame matches the first, "
+                    "e.g. to check that blended layers don't feed back." },
+        { "golden", "Compare checksums against this file, fail on mismatch.", "file" },
+        { "write-golden", "Write checksums of this run to a file.", "file" },
+        { "kernels", "Also run the kernel micro-benchmarks (first effect)." },
+        { "min-time", "Minimum time per kernel benchmark in ms (default 200).", "ms" },
+        { "json", "Also write results as JSON to this file.", "file" },
+    });
+    parser.process(app);
+
+    options.effectIds = parser.values("effect");
+    options.goldenFile = parser.value("golden");
+    options.writeGoldenFile = parser.value("write-golden");
+    options.jsonFile = parser.value("json");
+    options.kernels = parser.isSet("kernels");
+    options.deviceSpec = parser.value("devices");
+    options.asyncOutput = parser.isSet("async-output");
+    options.countAllocations = parser.isSet("count-allocations");
+    options.checkStatic = parser.isSet("static");
+
+    bool ok = true;
+    if (parser.isSet("frames"))      options.frames = parser.value("frames").toInt(&ok);
+    if (ok && parser.isSet("timestep"))    options.timestep = parser.value("timestep").toDouble(&ok);
+    if (ok && parser.isSet("controllers")) options.controllers = parser.value("controllers").toInt(&ok);
+    if (ok && parser.isSet("zones"))       options.zones = parser.value("zones").toInt(&ok);
+    if (ok && parser.isSet("leds"))        options.ledsPerZone = parser.value("leds").toInt(&ok);
+    if (ok && parser.isSet("min-time"))    options.kernelMinTime = parser.value("min-time").toInt(&ok);
+    if (ok && parser.isSet("latency"))     options.latencyMs = parser.value("latency").toDouble(&ok);
+    if (ok && parser.isSet("jitter"))      options.jitterMs = parser.value("jitter").toDouble(&ok);
+    if (ok && parser.isSet("grid"))        ok = parseDimensions(parser.value("grid"), options.grid);
+    if (ok && parser.isSet("opacity"))     options.layer.opacity = parser.value("opacity").toInt(&ok);
+    if (ok && parser.isSet("blend")) {
+        options.layer.mode = blendModeFromString(parser.value("blend"));
+        ok = (blendModeToString(options.layer.mode) == parser.value("blend").toLower());
+    }
+
+    if (ok && !options.deviceSpec.isEmpty()) {
+        std::string error;
+        if (!MockControllerBackend::ParseSpecs(options.deviceSpec.toStdString(), options.deviceSpecs, &error)) {
+            fprintf(stderr, "Invalid --devices: %s\n", error.c_str());
+            return false;
+        }
+    }
+
+    if (!ok || options.frames <= 0 || options.timestep <= 0.0 || options.kernelMinTime <= 0 ||
+        options.controllers <= 0 || options.zones <= 0 || options.ledsPerZone <= 0 || options.jitterMs < 0.0 ||
+        options.layer.opacity < 0 || options.layer.opacity > 100 ||
+        (parser.isSet("jitter") && !parser.isSet("latency"))) {
+        fprintf(stderr, "Invalid arguments, see --help\n");
+        return false;
+    }
+    return true;
+}
+
+QStringList registeredEffectIds()
+{
+    QStringList ids;
+    const auto categories = EffectRegistry::getInstance().getCategorizedEffects();
+    for (const QList<EffectInfo>& effects : categories) {
+        for (const EffectInfo& info : effects) {
+            ids.append(info.id);
+        }
+    }
+    ids.sort();
+    return ids;
+}
+
+// Mock controllers, the grid and one DeviceInfo per LED
+struct BenchScene {
+    MockControllerBackend controllers;
+    DeviceManager deviceManager;
+    SpatialGrid grid;
+    std::vector<DeviceInfo> devices;
+
+    explicit BenchScene(const BenchOptions& options);
+};
+
+// LEDs are spread over the grid cells in x, y, z order
+BenchScene::BenchScene(const BenchOptions& options)
+    : controllers(options.controllerSpecs())
+    , deviceManager(&controllers, nullptr)
+{
+    grid.SetDimensions(options.grid);
+
+    const int cellCount = options.grid.width * options.grid.height * options.grid.depth;
+    int cell = 0;
+    SpatialGrid::AssignmentBatch batch(&grid);
+
+    for (unsigned int index = 0; index < deviceManager.GetRGBDeviceCount(); index++) {
+        int ledCount = static_cast<int>(deviceManager.GetLEDCount(index));
+        for (int led = 0; led < ledCount; led++, cell = (cell + 1) % cellCount) {
+            DeviceInfo device;
+            device.index = static_cast<int>(index);
+            device.type = DeviceType::RGB;
+            device.ledIndex = led;
+            device.position = GridPosition(cell % options.grid.width,
+                                           (cell / options.grid.width) % options.grid.height,
+                                           cell / (options.grid.width * options.grid.height));
+            devices.push_back(device);
+
+            grid.AddAssignment(device.position, DeviceAssignment(index, DeviceType::RGB, -1, led));
+        }
+    }
+}
+
+BaseEffect* createEffect(const QString& effectId, BenchScene& scene)
+{
+    BaseEffect* effect = static_cast<BaseEffect*>(EffectRegistry::getInstance().createEffect(effectId));
+    if (!effect) {
+        fprintf(stderr, "Unknown effect: %s\n", qPrintable(effectId));
+        return nullptr;
+    }
+
+    effect->initialize(&scene.deviceManager, &scene.grid);
+    effect->start();
+    return effect;
+}
+
+bool runEffect(const QString& effectId, const BenchOptions& options, BenchResult& result)
+{
+    BenchScene scene(options);
+    BaseEffect* effect = createEffect(effectId, scene);
+    if (!effect) return false;
+
+    // Same frame pipeline as the render thread: one layer per effect, one flush per frame
+    FrameCompositor compositor(&scene.deviceManager);
+    compositor.setAsyncOutput(options.asyncOutput);
+    const float deltaTime = options.checkStatic ? 0.0f : static_cast<float>(options.timestep);
+    quint64 checksum = FnvOffset;
+    quint64 firstFrame = 0;
+    std::chrono::steady_clock::duration elapsed{0};
+
+    for (int frame = 0; frame < options.frames; frame++) {
+        if (options.countAllocations && frame == AllocationWarmupFrames) {
+            allocationCount.store(0, std::memory_order_relaxed);
+            countingAllocations.store(true, std::memory_order_relaxed);
+        }
+
+        auto frameStart = std::chrono::steady_clock::now();
+
+        compositor.beginFrame();
+        compositor.beginLayer(options.layer);
+        effect->update(deltaTime);
+        effect->renderToCompositor(scene.devices, compositor);
+        compositor.endLayer();
+        compositor.flush();
+
+        elapsed += std::chrono::steady_clock::now() - frameStart;
+
+        // Output threads size their buffers on their first writes; make sure those
+        // happen in the warm-up frames rather than whenever the threads catch up
+        if (options.countAllocations && options.asyncOutput && frame < AllocationWarmupFrames) {
+            scene.deviceManager.FlushOutput();
+        }
+
+        // The output threads own the controller colors until they are flushed
+        if (!options.asyncOutput) {
+            for (RGBController* controller : scene.controllers.GetRGBControllers()) {
+                checksum = hashColors(checksum, controller->colors);
+            }
+        }
+
+        // Nothing moves, so any difference is the compositor feeding a frame into the next
+        if (options.checkStatic) {
+            if (options.asyncOutput) scene.deviceManager.FlushOutput();
+
+            quint64 frameHash = FnvOffset;
+            for (RGBController* controller : scene.controllers.GetRGBControllers()) {
+                frameHash = hashColors(frameHash, controller->colors);
+            }
+            if (frame == 0) {
+                firstFrame = frameHash;
+            } else if (frameHash != firstFrame && result.firstChangedFrame < 0) {
+                result.firstChangedFrame = frame + 1;
+            }
+        }
+    }
+
+    if (countingAllocations.exchange(false, std::memory_order_relaxed)) {
+        result.allocations = allocationCount.load(std::memory_order_relaxed);
+    }
+
+    if (options.asyncOutput) {
+        auto flushStart = std::chrono::steady_clock::now();
+        scene.deviceManager.FlushOutput();
+        elapsed += std::chrono::steady_clock::now() - flushStart;
+
+        for (RGBController* controller : scene.controllers.GetRGBControllers()) {
+            checksum = hashColors(checksum, controller->colors);
+        }
+        for (const DeviceOutputPool::ControllerStatistics& stats : scene.deviceManager.GetOutputStatistics()) {
+            result.droppedFrames += stats.dropped;
+        }
+    }
+
+    effect->stop();
+    delete effect;
+
+    result.effectId = effectId;
+    result.frames = options.frames;
+    result.ledsPerFrame = scene.controllers.GetTotalLEDCount();
+    result.seconds = std::chrono::duration<double>(elapsed).count();
+    result.checksum = checksum;
+    result.sentUpdates = scene.deviceManager.GetSentUpdateCount();
+    result.skippedUpdates = scene.deviceManager.GetSkippedUpdateCount();
+
+    MockWriteLog::Totals writes = scene.controllers.GetWriteLog().GetTotals();
+    result.deviceWrites = writes.writes;
+    result.maxWriteMs = std::chrono::duration<double, std::milli>(writes.longest).count();
+    if (writes.writes > 0) {
+        result.meanWriteMs = std::chrono::duration<double, std::milli>(writes.busy).count() / writes.writes;
+    }
+    return true;
+}
+
+bool runKernels(const QString& effectId, const BenchOptions& options, QList<KernelResult>& results)
+{
+    BenchScene scene(options);
+    BaseEffect* effect = createEffect(effectId, scene);
+    if (!effect) return false;
+
+    results = runKernelBenchmarks(scene.grid, scene.devices, effect,
+                                  std::chrono::milliseconds(options.kernelMinTime));
+
+    effect->stop();
+    delete effect;
+    return true;
+}
+
+// Golden file: one "<effect id> <config key> <checksum>" entry per line
+QMap<QString, QString> readGolden(const QString& path)
+{
+    QMap<QString, QString> golden;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return golden;
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString line = in.readLine().simplified();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        QStringList parts = line.split(' ');
+        if (parts.size() == 3) {
+            golden[parts[0] + ' ' + parts[1]] = parts[2];
+        }
+    }
+    return golden;
+}
+
+bool writeGolden(const QString& path, const BenchOptions& options, const QList<BenchResult>& results)
+{
+    QMap<QString, QString> golden = readGolden(path);
+    for (const BenchResult& result : results) {
+        golden[result.effectId + ' ' + options.configKey()] = QString::number(result.checksum, 16);
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) return false;
+
+    QTextStream out(&file);
+    out << "# <effect id> <config> <checksum>, written by LightscapeBench --write-golden\n";
+    for (auto it = golden.constBegin(); it != golden.constEnd(); ++it) {
+        out << it.key() << ' ' << it.value() << '\n';
+    }
+    return true;
+}
+
+void printResults(const BenchOptions& options, const QList<BenchResult>& results, const QList<KernelResult>& kernels)
+{
+    printf("Config: %s\n", qPrintable(options.configKey()));
+    printf("%-24s %8s %10s %12s %14s %8s %8s %8s %9s  %s\n",
+           "Effect", "Frames", "LEDs", "Frames/s", "LEDs/s", "Sent", "Skipped", "Dropped", "Max ms", "Checksum");
+    for (const BenchResult& result : results) {
+        printf("%-24s %8d %10zu %12.1f %14.0f %8llu %8llu %8llu %9.2f  %016llx\n",
+               qPrintable(result.effectId), result.frames, result.ledsPerFrame,
+               result.framesPerSecond(), result.ledsPerSecond(),
+               static_cast<unsigned long long>(result.sentUpdates),
+               static_cast<unsigned long long>(result.skippedUpdates),
+               static_cast<unsigned long long>(result.droppedFrames),
+               result.maxWriteMs,
+               static_cast<unsigned long long>(result.checksum));
+    }
+
+    if (options.countAllocations) {
+        printf("\nHeap allocations after %d warm-up frames:\n", AllocationWarmupFrames);
+        for (const BenchResult& result : results) {
+            printf("%-24s %8llu\n", qPrintable(result.effectId), static_cast<unsigned long long>(result.allocations));
+        }
+    }
+
+    if (kernels.isEmpty()) return;
+
+    printf("\n%-42s %12s %14s %14s\n", "Kernel", "Iterations", "ns/iteration", "Items/s");
+    for (const KernelResult& kernel : kernels) {
+        printf("%-42s %12llu %14.1f %14.0f\n",
+               qPrintable(kernel.name), static_cast<unsigned long long>(kernel.iterations),
+               kernel.nanosecondsPerIteration, kernel.itemsPerSecond());
+    }
+}
+
+bool writeJson(const QString& path, const BenchOptions& options, const QList<BenchResult>& results,
+               const QList<KernelResult>& kernels)
+{
+    QJsonArray effectArray;
+    for (const BenchResult& result : results) {
+        QJsonObject object;
+        object["effect"] = result.effectId;
+        object["frames"] = result.frames;
+        object["leds_per_frame"] = static_cast<qint64>(result.ledsPerFrame);
+        object["seconds"] = result.seconds;
+        object["frames_per_second"] = result.framesPerSecond();
+        object["leds_per_second"] = result.ledsPerSecond();
+        object["checksum"] = QString::number(result.checksum, 16);
+        object["sent_updates"] = static_cast<qint64>(result.sentUpdates);
+        object["skipped_updates"] = static_cast<qint64>(result.skippedUpdates);
+        object["dropped_frames"] = static_cast<qint64>(result.droppedFrames);
+        object["device_writes"] = static_cast<qint64>(result.deviceWrites);
+        object["mean_write_ms"] = result.meanWriteMs;
+        object["max_write_ms"] = result.maxWriteMs;
+        if (options.countAllocations) {
+            object["steady_state_allocations"] = static_cast<qint64>(result.allocations);
+        }
+        effectArray.append(object);
+    }
+
+    QJsonArray kernelArray;
+    for (const KernelResult& kernel : kernels) {
+        QJsonObject object;
+        object["name"] = kernel.name;
+        object["iterations"] = static_cast<qint64>(kernel.iterations);
+        object["items_per_iteration"] = static_cast<qint64>(kernel.itemsPerIteration);
+        object["ns_per_iteration"] = kernel.nanosecondsPerIteration;
+        object["items_per_second"] = kernel.itemsPerSecond();
+        kernelArray.append(object);
+    }
+
+    QJsonObject root;
+    root["config"] = options.configKey();
+    root["effects"] = effectArray;
+    root["kernels"] = kernelArray;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // Effects are widgets, so a QApplication is needed, but never a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("LightscapeBench");
+
+    BenchOptions options;
+    if (!parseArguments(app, options)) return 2;
+
+    if (options.effectIds.isEmpty()) {
+        options.effectIds = registeredEffectIds();
+    }
+
+    QList<BenchResult> results;
+    for (const QString& effectId : options.effectIds) {
+        BenchResult result;
+        if (!runEffect(effectId, options, result)) return 2;
+        results.append(result);
+    }
+
+    QList<KernelResult> kernels;
+    if (options.kernels && !options.effectIds.isEmpty() && !runKernels(options.effectIds.first(), options, kernels)) {
+        return 2;
+    }
+
+    printResults(options, results, kernels);
+
+    if (!options.jsonFile.isEmpty() && !writeJson(options.jsonFile, options, results, kernels)) {
+        fprintf(stderr, "Could not write %s\n", qPrintable(options.jsonFile));
+        return 2;
+    }
+
+    if (!options.writeGoldenFile.isEmpty() && !writeGolden(options.writeGoldenFile, options, results)) {
+        fprintf(stderr, "Could not write %s\n", qPrintable(options.writeGoldenFile));
+        return 2;
+    }
+
+    // Compare against the golden checksums for this configuration
+    int mismatches = 0;
+    if (!options.goldenFile.isEmpty()) {
+        QMap<QString, QString> golden = readGolden(options.goldenFile);
+        for (const BenchResult& result : results) {
+            QString key = result.effectId + ' ' + options.configKey();
+            QString actual = QString::number(result.checksum, 16);
+            if (!golden.contains(key)) {
+                fprintf(stderr, "No golden checksum for %s\n", qPrintable(key));
+            } else if (golden.value(key) != actual) {
+                fprintf(stderr, "Checksum mismatch for %s: expected %s, got %s\n",
+                        qPrintable(key), qPrintable(golden.value(key)), qPrintable(actual));
+                mismatches++;
+            }
+        }
+    }
+
+    // A frozen effect must give the same frame every time
+    int changing = 0;
+    if (options.checkStatic) {
+        for (const BenchResult& result : results) {
+            if (result.firstChangedFrame > 0) {
+                fprintf(stderr, "%s: frame %d differs from frame 1 with time frozen\n",
+                        qPrintable(result.effectId), result.firstChangedFrame);
+                changing++;
+            }
+        }
+    }
+
+    // A steady-state frame must not touch the heap
+    int allocating = 0;
+    if (options.countAllocations) {
+        for (const BenchResult& result : results) {
+            if (result.allocations > 0) {
+                fprintf(stderr, "%s allocated %llu times in steady-state frames\n",
+                        qPrintable(result.effectId), static_cast<unsigned long long>(result.allocations));
+                allocating++;
+            }
+        }
+    }
+
+    return (mismatches > 0 || changing > 0 || allocating > 0) ? 1 : 0;
+}